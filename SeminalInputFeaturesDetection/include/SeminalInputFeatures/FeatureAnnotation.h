@@ -0,0 +1,37 @@
+#ifndef FEATURE_ANNOTATION_H
+#define FEATURE_ANNOTATION_H
+
+// Seminal features attached to the IR as metadata, so later passes and tools
+// read them from the bitcode instead of re-running the analysis.
+//
+// A loop gets a !{!"seminal.features", !F...} property in its llvm.loop
+// metadata; a branch or switch gets a !seminal.features attachment !{!F...}.
+// Each !F describes one feature read by the condition:
+//   !{!"name", !"IO" or !"Potential", DILocalVariable or null, call site of each input call...}
+// where the input calls are those whose data reaches both the feature and the
+// condition. A call site is the call's DILocation in a loop property; the
+// verifier rejects DILocations in other attachments, so in a branch's it is
+// !{i32 line, i32 column, DILocation scope}.
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+    class Instruction;
+    class Loop;
+    class MDNode;
+    class Module;
+    class SeminalFeatureInfo;
+
+    // Annotates the loops and branches of F whose conditions read reported features of 'info', the
+    // SeminalFeatureAnalysis result of F. Annotations from an earlier run are replaced.
+    void annotateSeminalFeatures(Function &F, const SeminalFeatureInfo &info);
+
+    // Annotates every function defined in M, with the results visitModuleSeminalFeatures gives.
+    void annotateModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM);
+
+    // The feature list attached to a loop or to a branch, or nullptr if it has none.
+    MDNode *getSeminalFeatureAnnotation(const Loop &L);
+    MDNode *getSeminalFeatureAnnotation(const Instruction &branch);
+}
+
+#endif
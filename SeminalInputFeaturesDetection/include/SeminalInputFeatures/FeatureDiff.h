@@ -0,0 +1,77 @@
+#ifndef FEATURE_DIFF_H
+#define FEATURE_DIFF_H
+
+// Differential mode: which loops depend on which seminal features in two
+// versions of a module, and what changed between them.
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "nlohmann/json.hpp"
+#include <string>
+#include <vector>
+
+namespace llvm {
+    class FeatureSummaryIndex;
+    class Function;
+    class IndirectCallTargets;
+    class Module;
+    class ModuleSlotTracker;
+
+    // A reported feature read by the exit condition of a loop.
+    struct FeatureEdge {
+        std::string feature;
+        bool fromInput = false;
+        std::vector<std::string> inputs;   // sorted callees of the input calls writing the feature
+        std::vector<unsigned> inputLines;
+    };
+
+    struct LoopEdges {
+        unsigned line = 0;
+        unsigned depth = 0;
+        std::vector<FeatureEdge> edges;    // sorted by feature name
+    };
+
+    struct FunctionEdges {
+        std::string function;
+        uint64_t hash = 0;                 // hashModuleFunctions
+        uint64_t shapeHash = 0;            // FunctionComparator::functionHash, to pair up renamed functions
+        bool analyzed = false;             // false when the other version has the same hash
+        std::vector<LoopEdges> loops;      // in the order of the analysis' loop list
+    };
+
+    // Feature -> loop edges of one module version, in module order.
+    struct FeatureEdgeIndex {
+        std::vector<FunctionEdges> functions;
+
+        // Reads or writes the file of seminal-batch -edge-index.
+        bool load(const std::string &path);
+        nlohmann::json toJson() const;
+    };
+
+    // Hashes the code of F that its analysis reads: its instructions, debug
+    // info and profile counts. The report of F also depends on other functions
+    // of the module; hashModuleFunctions covers them.
+    uint64_t hashFunctionForAnalysis(const Function &F, ModuleSlotTracker &MST);
+
+    // Hashes what the report of every function defined in M depends on, by
+    // name, in module order: hashFunctionForAnalysis of the function and of
+    // every function its report may see, i.e. its callees in M, the targets of
+    // its calls through function pointers, and the functions writing the
+    // globals it reads, transitively. Two versions of a function with the same
+    // hash have the same report. Without 'indirectCalls', they are computed.
+    std::vector<std::pair<std::string, uint64_t>> hashModuleFunctions(Module &M,
+                                                                      const IndirectCallTargets *indirectCalls = nullptr);
+
+    // Builds the edge index of M. Every defined function is hashed, but only
+    // those for which 'needsEdges' returns true are analyzed.
+    FeatureEdgeIndex buildFeatureEdgeIndex(Module &M, const FeatureSummaryIndex *summaries,
+                                           function_ref<bool(StringRef name, uint64_t hash)> needsEdges);
+
+    // Reports the feature -> loop edges added, removed and changed from
+    // 'before' to 'after', as a JSON array with one entry per function that
+    // has any. Functions are matched by name, then by shape among the
+    // unmatched ones; functions with equal hashes are skipped.
+    nlohmann::json diffFeatureEdges(const FeatureEdgeIndex &before, const FeatureEdgeIndex &after);
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef FEATURE_SPECIALIZATION_PASS_H
+#define FEATURE_SPECIALIZATION_PASS_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+// Clones the function controlled by a seminal input feature once per hot
+// profiled value of that feature, with the value folded in as a constant,
+// and adds an entry dispatch from the original function to the clones.
+struct FeatureSpecializationPass : PassInfoMixin<FeatureSpecializationPass> {
+    PreservedAnalyses run(Module &M, ModuleAnalysisManager &MAM);
+};
+
+}  // namespace llvm
+
+#endif  // FEATURE_SPECIALIZATION_PASS_H
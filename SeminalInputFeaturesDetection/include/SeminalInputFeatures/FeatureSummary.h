@@ -0,0 +1,170 @@
+#ifndef FEATURE_SUMMARY_H
+#define FEATURE_SUMMARY_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/PassManager.h"
+#include "nlohmann/json.hpp"
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace llvm {
+    class CallBase;
+    class Function;
+    class GlobalVariable;
+    class IndirectCallTargets;
+    class LoopInfo;
+    class Module;
+
+    // Taint summary of one exported function, as seen from its call sites.
+    struct FunctionFeatureSummary {
+        bool readsInput = false;           // calls an input function, directly or through callees
+        bool returnsInput = false;         // the return value is derived from input
+        std::set<unsigned> inputParams;    // pointer parameters the function writes input through
+        std::set<unsigned> loopParams;     // parameters that bound a loop of the function
+        std::set<std::string> calls;       // external callees, used by the global merge
+        std::set<std::string> returnCalls; // external callees whose result reaches the return value
+        // External callee -> (its parameter, parameter of this function): the pointer parameter passed to it as is,
+        // or the parameters the argument is computed from, used by the global merge.
+        std::map<std::string, std::set<std::pair<unsigned, unsigned>>> pointerArgs;
+        std::map<std::string, std::set<std::pair<unsigned, unsigned>>> valueArgs;
+    };
+
+    // Combined summary index over the exported functions of many modules.
+    // Module summaries are added one at a time, so building the index never
+    // needs more than one module in memory.
+    class FeatureSummaryIndex {
+    public:
+        // Adds the summaries of one module, as returned by summarizeModule.
+        void addModule(const nlohmann::json &moduleSummary);
+
+        // Thin global merge: propagates readsInput and returnsInput across
+        // call edges between summaries, inputParams across pointerArgs edges
+        // and loopParams across valueArgs edges, until nothing changes.
+        void propagate();
+
+        const FunctionFeatureSummary *lookup(StringRef name) const;
+
+        // Reads or writes the combined index file.
+        bool load(const std::string &path);
+        nlohmann::json toJson() const;
+
+        size_t size() const { return functions.size(); }
+
+    private:
+        std::map<std::string, FunctionFeatureSummary> functions;
+    };
+
+    // Summaries of the functions defined in one module, for the calls between them, computed on demand under
+    // k-limited call strings. The context of a call is the call followed by the calls leading to its caller, innermost
+    // first, at most 'depth' of them. A parameter carries input in a context when the argument passed to it does in the
+    // caller, under the rest of the string; past the end of the string, no parameter does. Each (function, call string)
+    // summary is computed once. Calls to declared functions get their imported summary, if any. A call through a
+    // function pointer gets the union of the summaries of its targets (see IndirectCallTargets), each under the call
+    // string the call extends; input functions among the targets read and return input.
+    //
+    // A larger depth keeps apart more of the callers of a helper, and the number of summaries grows with it; past
+    // 'maxContexts' of them (0: no limit), further calls get the context-insensitive summary of their callee instead.
+    class CallStringSummaries {
+    public:
+        CallStringSummaries(unsigned depth, unsigned maxContexts, const FeatureSummaryIndex *imported,
+                            const IndirectCallTargets *indirectCalls = nullptr);
+        CallStringSummaries(CallStringSummaries &&);
+        ~CallStringSummaries();
+
+        // The summary of CI's callee for the call CI, made by a function analyzed on its own. nullptr for input
+        // functions, callees without a summary, and indirect calls when no targets are known.
+        const FunctionFeatureSummary *lookup(const CallBase *CI);
+
+        // Number of (function, call string) summaries computed so far.
+        size_t contexts() const { return summaries.size(); }
+
+        // As the result of CallStringAnalysis: the summaries point into the IR and were computed with the module's
+        // IndirectCallTargets, so they go when a pass does not preserve them or those.
+        bool invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv);
+
+    private:
+        using CallString = std::vector<const CallBase *>;
+        struct FunctionInfo;
+
+        unsigned depth;
+        unsigned maxContexts;
+        const FeatureSummaryIndex *imported;
+        const IndirectCallTargets *indirectCalls;
+        std::map<std::pair<const Function *, CallString>, FunctionFeatureSummary> summaries;
+        std::map<std::pair<const CallBase *, CallString>, FunctionFeatureSummary> dispatches;  // merged target summaries
+        std::map<CallString, std::set<unsigned>> inputArguments;
+        std::map<const Function *, std::unique_ptr<FunctionInfo>> functions;
+
+        CallString extend(const CallBase *CI, const CallString &context) const;
+        const FunctionFeatureSummary *calleeSummary(const CallBase *CI, const CallString &context);
+        const FunctionFeatureSummary &summary(const Function *F, CallString context);
+        const FunctionFeatureSummary &dispatchSummary(const CallBase *CI, const CallString &context);
+        const std::set<unsigned> &argumentsFromInput(const CallString &context);
+        FunctionInfo &functionInfo(const Function *F);
+    };
+
+    // Input stored into one global variable, anywhere in the module.
+    struct GlobalInputInfo {
+        std::vector<const CallBase *> sources;   // input calls whose data is stored into the global
+        std::vector<const Function *> readers;   // functions loading from it
+    };
+
+    // Which globals of a module are written with input-derived values, computed in one scan of the module so that
+    // the analysis of each function looks a global up instead of chasing its writers through other functions.
+    // A store into a global is input-derived when its backward slice reaches an input call, a call whose summary
+    // reads input (see CallStringSummaries), or another such global; input calls writing through a pointer into a
+    // global count as well. Constant globals, such as format strings, are never input. Calls through function
+    // pointers are resolved with 'indirectCalls', when given.
+    class GlobalInputSummary {
+    public:
+        explicit GlobalInputSummary(Module &M, const IndirectCallTargets *indirectCalls = nullptr);
+
+        // The input reaching GV, or nullptr if none does.
+        const GlobalInputInfo *lookup(const GlobalVariable *GV) const {
+            auto it = globals.find(GV);
+            return it == globals.end() ? nullptr : &it->second;
+        }
+
+        // Whether F loads from a global that lookup knows.
+        bool readsInput(const Function *F) const { return readers.count(F); }
+
+        size_t size() const { return globals.size(); }
+
+        // The summary points into the IR and was computed with the module's IndirectCallTargets, so it goes when a
+        // pass does not preserve it or them. SeminalFeatureAnalysis registers its results for outer invalidation,
+        // so the function results built on the summary go with it.
+        bool invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv);
+
+    private:
+        DenseMap<const GlobalVariable *, GlobalInputInfo> globals;
+        DenseSet<const Function *> readers;
+    };
+
+    // Module analysis computing the GlobalInputSummary. SeminalFeatureAnalysis uses the cached result when there is
+    // one, so drivers compute it before querying functions.
+    class GlobalInputAnalysis : public AnalysisInfoMixin<GlobalInputAnalysis> {
+        friend AnalysisInfoMixin<GlobalInputAnalysis>;
+        static AnalysisKey Key;
+
+    public:
+        using Result = GlobalInputSummary;
+
+        Result run(Module &M, ModuleAnalysisManager &MAM);
+    };
+
+    // Computes the summaries of the exported functions of M. The result is a
+    // JSON object mapping function names to summaries. With 'indirectCalls',
+    // the targets of calls through function pointers are callees as well.
+    // Static helpers get no summary of their own; the summary of each
+    // exported function includes those of the helpers it calls.
+    nlohmann::json summarizeModule(Module &M, function_ref<LoopInfo &(Function &)> getLoopInfo,
+                                   const IndirectCallTargets *indirectCalls = nullptr);
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef INDIRECT_CALLS_H
+#define INDIRECT_CALLS_H
+
+// Possible targets of the calls through function pointers of a module, such as
+// plugin tables, callbacks and virtual calls. They are resolved once per module,
+// and the call summaries, the global input summary and the function analyses
+// all share the result.
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/PassManager.h"
+#include <vector>
+
+namespace llvm {
+    class CallBase;
+    class Function;
+    class Module;
+    class Value;
+
+    // What one call through a function pointer may call.
+    struct IndirectCallInfo {
+        std::vector<const Function *> targets;   // in module order
+        std::vector<const Value *> conditions;   // select, branch and switch conditions deciding which pointer reaches the call
+        bool refined = false;                    // targets found by following the pointer, not only by its type
+    };
+
+    // Targets of the indirect calls of a module. A call may call every function whose address is taken and whose
+    // type fits its arguments and result; functions of the same signature are matched once. With
+    // -seminal-refine-indirect-calls (the default), the called pointer is also followed back within its function,
+    // through casts, selects, phis, allocas that are only loaded and stored, and constant tables of functions. When
+    // every pointer it reaches is a function, those functions are the targets, and the conditions of the selects,
+    // and of the branches the stores and phi edges depend on, are recorded as what chooses among them.
+    class IndirectCallTargets {
+    public:
+        explicit IndirectCallTargets(Module &M);
+
+        // The targets of CB, or nullptr for a direct call or inline assembly. A call of a function cast to another
+        // type has that function as its only target.
+        const IndirectCallInfo *lookup(const CallBase *CB) const {
+            auto it = calls.find(CB);
+            return it == calls.end() ? nullptr : &it->second;
+        }
+
+        size_t size() const { return calls.size(); }
+
+        // The targets point into the IR, so they go when a pass does not preserve them.
+        bool invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv);
+
+    private:
+        DenseMap<const CallBase *, IndirectCallInfo> calls;
+    };
+
+    // Module analysis computing the IndirectCallTargets. GlobalInputAnalysis requires it, so drivers computing the
+    // global summary get both.
+    class IndirectCallAnalysis : public AnalysisInfoMixin<IndirectCallAnalysis> {
+        friend AnalysisInfoMixin<IndirectCallAnalysis>;
+        static AnalysisKey Key;
+
+    public:
+        using Result = IndirectCallTargets;
+
+        Result run(Module &M, ModuleAnalysisManager &) { return IndirectCallTargets(M); }
+    };
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef SEMINAL_FEATURE_ANALYSIS_H
+#define SEMINAL_FEATURE_ANALYSIS_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/IR/PassManager.h"
+#include "nlohmann/json.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llvm {
+    class AAResults;
+    class BasicBlock;
+    class BlockFrequencyInfo;
+    class CallBase;
+    class CallStringSummaries;
+    class DbgDeclareInst;
+    class FeatureSummaryIndex;
+    class Function;
+    class GlobalInputSummary;
+    class IndirectCallTargets;
+    class Instruction;
+    class Loop;
+    class LoopInfo;
+    class Module;
+    class Value;
+    class raw_ostream;
+
+    // True for the library calls treated as input sources (scanf, fopen, getc and their variants).
+    bool isInputFunction(const Function *F);
+
+    // A source variable found on the def-use chains of a function.
+    struct SeminalFeature {
+        std::string name;
+        unsigned line = 0;
+        bool fromInput = false;                      // written by an input call ("IO"), not only a candidate ("Potential")
+        const DbgDeclareInst *declaration = nullptr; // where name and line come from at -O0
+        const Value *value = nullptr;                // in optimized IR, the SSA value the name comes from instead
+        std::vector<const CallBase *> sources;       // the input calls that write the variable
+        std::vector<const CallBase *> origins;       // the input calls whose data reaches it, directly or through other variables
+        double score = 0;                            // hotness of the loops and branches the variable controls; executions with a profile
+        bool cold = false;                           // with a profile, every loop and branch it controls is cold; not reported
+    };
+
+    // An immutable, ordered set that is hash-consed while a function is analyzed: the control points whose conditions
+    // read the same variables, or are reached by the same input calls, share one copy. Read it like a const vector.
+    template <typename T> class InternedSet {
+    public:
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        InternedSet() = default;
+        explicit InternedSet(std::shared_ptr<const std::vector<T>> storage) : storage(std::move(storage)) {}
+
+        const std::vector<T> &elements() const { return storage ? *storage : none(); }
+        const_iterator begin() const { return elements().begin(); }
+        const_iterator end() const { return elements().end(); }
+        size_t size() const { return elements().size(); }
+        bool empty() const { return elements().empty(); }
+
+        // Two sets interned for the same function are equal exactly when their identities are.
+        const void *identity() const { return storage.get(); }
+        bool operator==(const InternedSet &other) const { return storage == other.storage || elements() == other.elements(); }
+        bool operator!=(const InternedSet &other) const { return !(*this == other); }
+
+    private:
+        std::shared_ptr<const std::vector<T>> storage;   // null for the empty set
+
+        static const std::vector<T> &none() {
+            static const std::vector<T> empty;
+            return empty;
+        }
+    };
+
+    // A loop exit or conditional branch, with the variables its condition reads.
+    struct SeminalControlPoint {
+        const Instruction *terminator = nullptr;     // conditional br or switch; for loops, the header's exit if it has one
+        const Loop *loop = nullptr;                  // set for loops, whose exiting blocks are merged into one entry
+        InternedSet<std::string> variables;          // sorted names of the variables the condition depends on
+        InternedSet<const CallBase *> sources;       // the input calls whose data reaches the condition, in function order
+    };
+
+    // A call through a function pointer with several possible targets, with the variables that choose among them.
+    struct SeminalDispatch {
+        const CallBase *call = nullptr;
+        std::vector<const Function *> targets;       // as resolved by the module's IndirectCallTargets
+        InternedSet<std::string> variables;          // sorted names of the variables the called pointer and the conditions choosing it read
+        InternedSet<const CallBase *> sources;       // the input calls whose data reaches them, in function order
+        bool inputSelected = false;                  // input reaches the choice: through 'sources' or a variable written by input
+    };
+
+    // Peak bytes held by the def-use walks of one function, measured with -seminal-memory-report.
+    struct SeminalMemoryUsage {
+        uint64_t visitedSets = 0;                    // visited sets of the walks
+        uint64_t variableMaps = 0;                   // variable, IO variable and value flow maps
+        uint64_t total = 0;                          // both together; not the sum of the two peaks
+    };
+
+    // Result of SeminalFeatureAnalysis for one function.
+    class SeminalFeatureInfo {
+    public:
+        std::vector<SeminalFeature> features;        // sorted by line, then name
+        std::vector<SeminalControlPoint> loops;      // every loop of the function, in preorder
+        std::vector<SeminalControlPoint> branches;   // conditional branches and switches that do not exit a loop
+        std::vector<SeminalDispatch> dispatches;     // indirect calls with several targets, in function order; needs IndirectCallTargets
+        std::vector<const CallBase *> sources;       // input calls, including calls of functions whose summary reads input
+        uint64_t steps = 0;                          // def-use walk steps spent on the function
+        bool degraded = false;                       // the walks exceeded their budget and the result is an over-approximation
+        std::string degradedReason;                  // which budget was exceeded, e.g. "step budget exceeded"
+        SeminalMemoryUsage memory;                   // all zero unless -seminal-memory-report is given
+
+        const SeminalFeature *lookup(StringRef name) const;
+        bool hasInputFeatures() const;
+
+        // The features that are reported: those written by input if there are any, otherwise every candidate.
+        // They are ordered by score, hottest first, and limited to -seminal-top-k. Cold features are left out.
+        std::vector<const SeminalFeature *> reportedFeatures() const;
+
+        // The number of features that would be reported if they were not cold.
+        size_t coldFeatures() const;
+
+        // The dispatches whose target input selects.
+        std::vector<const SeminalDispatch *> inputDispatches() const;
+
+        // The result refers to instructions and loops of the function, so it is kept only across passes that
+        // preserve it (or all function analyses) and leave LoopInfo intact.
+        bool invalidate(Function &F, const PreservedAnalyses &PA, FunctionAnalysisManager::Invalidator &Inv);
+    };
+
+    // Function analysis computing the seminal input features of a function. Downstream passes in the same
+    // pipeline query it with FAM.getResult<SeminalFeatureAnalysis>(F) and share the cached result.
+    class SeminalFeatureAnalysis : public AnalysisInfoMixin<SeminalFeatureAnalysis> {
+        friend AnalysisInfoMixin<SeminalFeatureAnalysis>;
+        static AnalysisKey Key;
+
+        const FeatureSummaryIndex *summaries;
+        ModuleAnalysisManager *moduleAnalyses;
+
+    public:
+        using Result = SeminalFeatureInfo;
+
+        // Calls covered by the optional summary index, and calls of functions defined in the module, are treated
+        // according to their summaries. The GlobalInputAnalysis, IndirectCallAnalysis, CallStringAnalysis and
+        // SeminalProfileAnalysis results cached in moduleAnalyses, the manager of the enclosing module pipeline, are
+        // used when there are any. They are read from it directly, since the module proxy only hands out results that
+        // no pass can invalidate.
+        explicit SeminalFeatureAnalysis(const FeatureSummaryIndex *summaries = nullptr,
+                                        ModuleAnalysisManager *moduleAnalyses = nullptr)
+            : summaries(summaries), moduleAnalyses(moduleAnalyses) {}
+
+        Result run(Function &F, FunctionAnalysisManager &FAM);
+    };
+
+    // Module analysis holding the CallStringSummaries of a module under -seminal-context-depth and
+    // -seminal-context-limit, so that every function analyzed in the module shares the summaries of the helpers they
+    // call, and the limit bounds the summaries of the whole module. Like GlobalInputAnalysis, drivers compute it
+    // before querying SeminalFeatureAnalysis, which otherwise summarizes the calls of each function on its own.
+    class CallStringAnalysis : public AnalysisInfoMixin<CallStringAnalysis> {
+        friend AnalysisInfoMixin<CallStringAnalysis>;
+        static AnalysisKey Key;
+
+        const FeatureSummaryIndex *summaries;
+
+    public:
+        using Result = CallStringSummaries;
+
+        // Calls of declared functions get their summary from the optional index, as in SeminalFeatureAnalysis.
+        explicit CallStringAnalysis(const FeatureSummaryIndex *summaries = nullptr) : summaries(summaries) {}
+
+        Result run(Module &M, ModuleAnalysisManager &MAM);
+    };
+
+    // Execution counts of the blocks of a module under the -seminal-profile instrumentation profile. The profile is
+    // applied to a copy of the module, as clang -fprofile-use would apply it, and the counts of each copied block are
+    // kept for the block it was copied from, so the analyzed module is left unchanged. Empty without -seminal-profile;
+    // modules compiled with a profile carry counts of their own.
+    class SeminalProfileCounts {
+    public:
+        // Whether F got counts. Functions whose control flow no longer matches the profile get none, with a warning.
+        bool hasCounts(const Function &F) const { return functions.count(&F); }
+
+        // The execution count of BB, 0 when it has none.
+        uint64_t count(const BasicBlock *BB) const {
+            auto it = blocks.find(BB);
+            return it == blocks.end() ? 0 : it->second;
+        }
+
+        // The largest count of the profile summary, which -seminal-cold-ratio is relative to.
+        uint64_t maxCount() const { return largest; }
+
+        // The counts point into the IR, so they go when a pass does not preserve them.
+        bool invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv);
+
+    private:
+        friend class SeminalProfileAnalysis;
+
+        DenseMap<const BasicBlock *, uint64_t> blocks;
+        DenseSet<const Function *> functions;
+        uint64_t largest = 0;
+    };
+
+    // Module analysis computing the SeminalProfileCounts. Like GlobalInputAnalysis, drivers compute it before
+    // querying SeminalFeatureAnalysis.
+    class SeminalProfileAnalysis : public AnalysisInfoMixin<SeminalProfileAnalysis> {
+        friend AnalysisInfoMixin<SeminalProfileAnalysis>;
+        static AnalysisKey Key;
+
+    public:
+        using Result = SeminalProfileCounts;
+
+        Result run(Module &M, ModuleAnalysisManager &MAM);
+    };
+
+    // Registers the module analyses SeminalFeatureAnalysis reads with MAM. Calls of declared functions get their summary
+    // from the optional index.
+    void registerSeminalModuleAnalyses(ModuleAnalysisManager &MAM, const FeatureSummaryIndex *summaries = nullptr);
+
+    // Computes the module analyses SeminalFeatureAnalysis reads but cannot query itself: SeminalProfileAnalysis,
+    // GlobalInputAnalysis and CallStringAnalysis (with the IndirectCallAnalysis they need). MAM must have them
+    // registered, and SeminalFeatureAnalysis must have been given MAM.
+    void computeSeminalModuleAnalyses(Module &M, ModuleAnalysisManager &MAM);
+
+    // The analysis managers of a driver analyzing modules outside an opt pipeline: the PassBuilder analyses and
+    // proxies, SeminalFeatureAnalysis (reading module results from MAM) and registerSeminalModuleAnalyses. It cannot be
+    // copied or moved, since SeminalFeatureAnalysis keeps a pointer to MAM.
+    struct SeminalAnalysisManagers {
+        LoopAnalysisManager LAM;
+        FunctionAnalysisManager FAM;
+        CGSCCAnalysisManager CGAM;
+        ModuleAnalysisManager MAM;
+        PassBuilder PB;
+
+        explicit SeminalAnalysisManagers(const FeatureSummaryIndex *summaries = nullptr);
+        SeminalAnalysisManagers(const SeminalAnalysisManagers &) = delete;
+        SeminalAnalysisManagers &operator=(const SeminalAnalysisManagers &) = delete;
+
+        // Runs computeSeminalModuleAnalyses on M, before any SeminalFeatureAnalysis query on its functions.
+        void prepare(Module &M) { computeSeminalModuleAnalyses(M, MAM); }
+    };
+
+    // Computes the result of SeminalFeatureAnalysis without an analysis manager. Without BFI, features are
+    // scored as if every block ran once; without AA, the def-use walks do not follow memory. A function whose
+    // walks exceed the -seminal-function-*-budget limits (or what is left of the -seminal-module-*-budget
+    // limits) gets a cheaper, degraded result instead. With the module's GlobalInputSummary, globals that input is
+    // stored into elsewhere in the module are features of the functions reading them. With its IndirectCallTargets,
+    // calls through function pointers get the summaries of their targets and are listed as dispatches. With the
+    // module's CallStringSummaries, the calls of F use and extend the summaries shared by the module; without, F gets
+    // summaries of its own. When F has profile counts, its own or those 'profile' gives, features are scored by the
+    // executions of what they control, and those controlling only cold blocks (see -seminal-cold-ratio) are marked cold.
+    SeminalFeatureInfo computeSeminalFeatures(Function &F, LoopInfo &LI, const BlockFrequencyInfo *BFI = nullptr,
+                                              AAResults *AA = nullptr,
+                                              const FeatureSummaryIndex *summaries = nullptr,
+                                              const GlobalInputSummary *globals = nullptr,
+                                              const IndirectCallTargets *indirectCalls = nullptr,
+                                              CallStringSummaries *callSummaries = nullptr,
+                                              const SeminalProfileCounts *profile = nullptr);
+
+    // Spreads the walks of large functions over one pool of 'threads' threads shared by every thread analyzing
+    // modules, instead of keeping them on the analyzing thread. Drivers that analyze modules in parallel size it to
+    // the cores their own workers leave idle. An explicit -seminal-function-threads takes precedence. Only the first
+    // call has an effect, and it must come before any analysis starts.
+    void shareSeminalWalkThreads(unsigned threads);
+
+    // Given the scores of all reported features of a module, in module order, returns which of them are
+    // within the -seminal-module-top-k hottest. Ties are kept in module order.
+    std::vector<bool> selectModuleTopFeatures(ArrayRef<double> scores);
+
+    // Prints the reported features of F to OS and appends the function's JSON entry (if any) to the
+    // moduleJson array. A non-empty degradedReason marks the entry as degraded. Input-selected dispatches
+    // are printed and listed under "input_dispatch".
+    void reportSeminalFeatures(const Function &F, ArrayRef<const SeminalFeature *> reported,
+                               nlohmann::json &moduleJson, raw_ostream &OS, StringRef degradedReason = StringRef(),
+                               ArrayRef<const SeminalDispatch *> dispatches = {});
+
+    // Calls consume with the result of every function defined in M, querying SeminalFeatureAnalysis from FAM.
+    // Structurally identical functions are analyzed only once (see -seminal-dedup-functions). The module
+    // budgets (-seminal-module-*-budget) are charged with every function analyzed here. Functions for which the
+    // optional 'skip' returns true are neither analyzed nor handed to consume, e.g. those whose earlier result the
+    // caller still holds.
+    void visitModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM,
+                                    function_ref<void(const Function &, const SeminalFeatureInfo &)> consume,
+                                    function_ref<bool(const Function &)> skip = nullptr);
+
+    // Runs visitModuleSeminalFeatures and reports every function with reportSeminalFeatures, keeping
+    // the -seminal-module-top-k hottest features of the module. With -seminal-memory-report, the per-function
+    // peaks and the module high-water mark are also stored in *memoryReport, if given.
+    void analyzeModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM, nlohmann::json &moduleJson,
+                                      raw_ostream &OS, nlohmann::json *memoryReport = nullptr);
+}
+
+#endif
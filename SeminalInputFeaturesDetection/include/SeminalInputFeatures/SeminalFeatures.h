@@ -0,0 +1,84 @@
+#ifndef SEMINAL_FEATURES_H
+#define SEMINAL_FEATURES_H
+
+// Public API of the SeminalFeatures library, for analyzing modules in-process.
+// Results are plain structs that do not refer to the IR, so they outlive the
+// module and its LLVMContext.
+
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+    class FeatureSummaryIndex;
+    class Function;
+    class Module;
+    class SeminalFeatureInfo;
+
+    enum class SeminalFeatureKind {
+        IO,         // written by an input call
+        Potential   // reaches a control point, but no input was found in the function
+    };
+
+    struct SeminalInputCallReport {
+        std::string callee;
+        unsigned line = 0;
+    };
+
+    // One reported variable; the same entries influential_variables.json lists.
+    struct SeminalVariableReport {
+        std::string name;
+        unsigned line = 0;
+        SeminalFeatureKind kind = SeminalFeatureKind::Potential;
+        std::vector<unsigned> inputLines;  // lines of the input calls that write the variable
+        std::vector<SeminalInputCallReport> origins;  // input calls whose data reaches the variable
+        double score = 0;                  // hotness of the loops and branches the variable controls; executions with a profile
+    };
+
+    // A loop or conditional branch and the variables its condition reads.
+    struct SeminalControlPointReport {
+        unsigned line = 0;
+        unsigned loopDepth = 0;            // nesting depth for loops, 0 for branches
+        std::vector<std::string> variables;
+        std::vector<SeminalInputCallReport> inputs;   // input calls whose data reaches the condition
+    };
+
+    // A call through a function pointer whose target input selects.
+    struct SeminalDispatchReport {
+        unsigned line = 0;
+        std::vector<std::string> targets;  // the functions it may call
+        std::vector<std::string> variables;           // variables the pointer and the conditions choosing it read
+        std::vector<SeminalInputCallReport> inputs;   // input calls whose data reaches them
+    };
+
+    struct SeminalFunctionReport {
+        std::string function;
+        std::vector<SeminalVariableReport> variables;     // hottest first, within -seminal-top-k and -seminal-module-top-k
+        std::vector<SeminalControlPointReport> loops;
+        std::vector<SeminalControlPointReport> branches;
+        std::vector<SeminalInputCallReport> inputCalls;
+        std::vector<SeminalDispatchReport> dispatches;    // input-selected indirect calls
+        bool degraded = false;             // over the analysis budget: the variables are a cheaper over-approximation
+        std::string degradedReason;
+    };
+
+    struct SeminalModuleReport {
+        std::vector<SeminalFunctionReport> functions;  // every function defined in the module, in module order
+    };
+
+    // Analyzes every function defined in M. Calls covered by the optional
+    // summary index are treated according to their summaries.
+    SeminalModuleReport analyzeModule(Module &M, const FeatureSummaryIndex *summaries = nullptr);
+
+    // Converts the SeminalFeatureAnalysis result of one function into its report. Unlike analyzeModule, the
+    // module-wide -seminal-module-top-k is not applied, so a function's report does not depend on the others.
+    SeminalFunctionReport reportFunction(const Function &F, const SeminalFeatureInfo &info);
+
+    // Parses a bitcode (or textual IR) buffer into a private LLVMContext and
+    // analyzes it. Concurrent calls from different threads are safe.
+    Expected<SeminalModuleReport> analyzeBitcode(MemoryBufferRef buffer,
+                                                 const FeatureSummaryIndex *summaries = nullptr);
+}
+
+#endif
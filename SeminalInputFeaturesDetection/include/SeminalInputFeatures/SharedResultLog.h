@@ -0,0 +1,53 @@
+#ifndef SHARED_RESULT_LOG_H
+#define SHARED_RESULT_LOG_H
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace llvm {
+    // Append-only record log shared by concurrent analysis processes, e.g. one
+    // opt or clang per translation unit under make -j. The file is memory
+    // mapped by every writer; space is reserved with an atomic add on the tail
+    // offset kept in the mapped header, so appends take no lock. Each record is
+    // marked committed after its payload is written, and records of writers
+    // that died before committing are skipped when the log is read.
+    class SharedResultLog {
+    public:
+        ~SharedResultLog();
+
+        // Opens the log at path, creating it with room for at least capacity
+        // bytes. Returns nullptr if the file cannot be created or mapped.
+        static std::unique_ptr<SharedResultLog> open(StringRef path, uint64_t capacity);
+
+        // Appends one record. Returns false if the log is full.
+        bool append(StringRef record);
+
+    private:
+        SharedResultLog() = default;
+
+        sys::fs::mapped_file_region region;
+    };
+
+    // Directory holding the per-translation-unit files written when the log
+    // at logPath is full or cannot be mapped.
+    std::string sharedResultFallbackDirectory(StringRef logPath);
+
+    // Appends record to the log at logPath, opened once per process, or
+    // writes it to a new file in the fallback directory through a temporary
+    // file and an atomic rename. Returns false only if both fail.
+    bool publishSharedResult(StringRef logPath, uint64_t capacity, StringRef record);
+
+    // Calls visit with every committed record of the log at logPath, in
+    // append order, then with every record in its fallback directory.
+    // Returns false if neither the log nor the fallback directory exists.
+    bool readSharedResults(StringRef logPath, function_ref<void(StringRef)> visit);
+
+    // Removes the log at logPath and its fallback directory.
+    void removeSharedResults(StringRef logPath);
+}
+
+#endif
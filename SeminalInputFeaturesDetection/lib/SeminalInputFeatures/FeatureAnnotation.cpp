@@ -0,0 +1,178 @@
+#include "SeminalInputFeatures/FeatureAnnotation.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+using namespace llvm;
+
+namespace {
+
+    const char *const SeminalFeaturesName = "seminal.features";
+
+    // The variable a feature is named after: its dbg.declare's, or in optimized IR the one a debug user of its value gives.
+    DILocalVariable *featureVariable(const SeminalFeature &feature) {
+        if (feature.declaration) {
+            return feature.declaration->getVariable();
+        }
+        if (!feature.value) {
+            return nullptr;
+        }
+        Value *V = const_cast<Value *>(feature.value);
+        SmallVector<DbgVariableIntrinsic *, 2> dbgUsers;
+#if LLVM_VERSION_MAJOR >= 19
+        SmallVector<DbgVariableRecord *, 2> dbgRecords;
+        findDbgUsers(dbgUsers, V, &dbgRecords);
+        if (!dbgRecords.empty()) {
+            return dbgRecords.front()->getVariable();
+        }
+#else
+        findDbgUsers(dbgUsers, V);
+#endif
+        return dbgUsers.empty() ? nullptr : dbgUsers.front()->getVariable();
+    }
+
+    // An input call site: its DILocation in llvm.loop properties; elsewhere the verifier only accepts DILocations in
+    // !dbg, so the site is spelled out as !{i32 line, i32 column, scope}.
+    Metadata *callSite(LLVMContext &context, DILocation *location, bool inLoopID) {
+        if (inLoopID) {
+            return location;
+        }
+        Type *int32 = Type::getInt32Ty(context);
+        return MDNode::get(context, {ConstantAsMetadata::get(ConstantInt::get(int32, location->getLine())),
+                                     ConstantAsMetadata::get(ConstantInt::get(int32, location->getColumn())),
+                                     location->getScope()});
+    }
+
+    // The input calls listed are those whose data reaches both the feature and the condition of 'point'; without
+    // attribution (a degraded result), the calls writing the feature.
+    MDNode *featureNode(LLVMContext &context, const SeminalFeature &feature, const SeminalControlPoint &point,
+                        bool inLoopID) {
+        SmallVector<Metadata *, 4> operands;
+        operands.push_back(MDString::get(context, feature.name));
+        operands.push_back(MDString::get(context, feature.fromInput ? "IO" : "Potential"));
+        operands.push_back(featureVariable(feature));
+        bool attributed = !point.sources.empty();
+        for (const CallBase *source : attributed ? feature.origins : feature.sources) {
+            if (attributed && !is_contained(point.sources, source)) {
+                continue;
+            }
+            if (DILocation *location = source->getDebugLoc().get()) {
+                operands.push_back(callSite(context, location, inLoopID));
+            }
+        }
+        return MDNode::get(context, operands);
+    }
+
+    bool isFeatureProperty(const Metadata *operand) {
+        const auto *property = dyn_cast_or_null<MDNode>(operand);
+        if (!property || property->getNumOperands() != 2) {
+            return false;
+        }
+        const auto *name = dyn_cast_or_null<MDString>(property->getOperand(0));
+        return name && name->getString() == SeminalFeaturesName;
+    }
+
+    /**
+     * Function: setLoopFeatures
+     *
+     * Description:
+     * Replaces the seminal.features property of L's llvm.loop metadata with 'features' (removes it when null), keeping
+     * every other property and the loop's DILocations. Loop IDs are distinct self-referential nodes, so a new one is built
+     * and set on all latches; a loop that had no ID gets one only if it has features.
+     */
+
+    void setLoopFeatures(Loop &L, MDNode *features) {
+        LLVMContext &context = L.getHeader()->getContext();
+        MDNode *loopID = L.getLoopID();
+        SmallVector<Metadata *, 4> operands{nullptr};
+        bool annotated = false;
+        if (loopID) {
+            for (unsigned i = 1; i < loopID->getNumOperands(); ++i) {
+                Metadata *operand = loopID->getOperand(i);
+                if (isFeatureProperty(operand)) {
+                    annotated = true;
+                } else {
+                    operands.push_back(operand);
+                }
+            }
+        }
+        if (!features && !annotated) {
+            return;
+        }
+        if (features) {
+            operands.push_back(MDNode::get(context, {MDString::get(context, SeminalFeaturesName), features}));
+        }
+        if (operands.size() == 1) {
+            L.setLoopID(nullptr);
+            return;
+        }
+        MDNode *newID = MDNode::getDistinct(context, operands);
+        newID->replaceOperandWith(0, newID);
+        L.setLoopID(newID);
+    }
+
+}  // end of anonymous namespace
+
+// The result refers to F's instructions and loops through const pointers; F itself is ours to modify.
+void llvm::annotateSeminalFeatures(Function &F, const SeminalFeatureInfo &info) {
+    LLVMContext &context = F.getContext();
+    std::vector<const SeminalFeature *> reported = info.reportedFeatures();
+    // Control points with the same (interned) variables and input calls get the same list, built once for loops and
+    // once for branches, which spell the call sites differently.
+    DenseMap<std::pair<const void *, const void *>, MDNode *> lists[2];
+    auto featureList = [&](const SeminalControlPoint &point, bool inLoopID) -> MDNode * {
+        auto cached = lists[inLoopID].try_emplace({point.variables.identity(), point.sources.identity()}, nullptr);
+        if (!cached.second) {
+            return cached.first->second;
+        }
+        SmallVector<Metadata *, 4> features;
+        for (const SeminalFeature *feature : reported) {
+            if (is_contained(point.variables, feature->name)) {
+                features.push_back(featureNode(context, *feature, point, inLoopID));
+            }
+        }
+        cached.first->second = features.empty() ? nullptr : MDNode::get(context, features);
+        return cached.first->second;
+    };
+    for (const SeminalControlPoint &loop : info.loops) {
+        if (loop.loop) {
+            setLoopFeatures(*const_cast<Loop *>(loop.loop), featureList(loop, /*inLoopID=*/true));
+        }
+    }
+    for (const SeminalControlPoint &branch : info.branches) {
+        if (branch.terminator) {
+            const_cast<Instruction *>(branch.terminator)->setMetadata(SeminalFeaturesName,
+                                                                      featureList(branch, /*inLoopID=*/false));
+        }
+    }
+}
+
+void llvm::annotateModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM) {
+    visitModuleSeminalFeatures(M, FAM, [](const Function &F, const SeminalFeatureInfo &info) {
+        annotateSeminalFeatures(const_cast<Function &>(F), info);
+    });
+}
+
+MDNode *llvm::getSeminalFeatureAnnotation(const Loop &L) {
+    MDNode *loopID = L.getLoopID();
+    if (!loopID) {
+        return nullptr;
+    }
+    for (unsigned i = 1; i < loopID->getNumOperands(); ++i) {
+        if (isFeatureProperty(loopID->getOperand(i))) {
+            return dyn_cast_or_null<MDNode>(cast<MDNode>(loopID->getOperand(i))->getOperand(1));
+        }
+    }
+    return nullptr;
+}
+
+MDNode *llvm::getSeminalFeatureAnnotation(const Instruction &branch) {
+    return branch.getMetadata(SeminalFeaturesName);
+}
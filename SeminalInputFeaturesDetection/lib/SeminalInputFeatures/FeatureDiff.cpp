@@ -0,0 +1,522 @@
+#include "SeminalInputFeatures/FeatureDiff.h"
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "SeminalInputFeatures/SeminalFeatures.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/FunctionComparator.h"
+#include <algorithm>
+#include <fstream>
+#include <optional>
+using namespace llvm;
+using Json = nlohmann::json;
+
+    /**
+     * Function: hashFunctionForAnalysis
+     *
+     * Description:
+     * Hashes the signature of F, the text of its instructions and the source locations and variables of its debug info.
+     * Metadata slot numbers ("!42") are left out of the text, because they shift when any other function of the module
+     * changes; the lines and names they stand for are hashed instead, as are the profile counts features are scored by.
+     */
+
+uint64_t llvm::hashFunctionForAnalysis(const Function &F, ModuleSlotTracker &MST) {
+    hash_code hash = hash_value(F.getName());
+    std::string text;
+    raw_string_ostream OS(text);
+    F.getFunctionType()->print(OS);
+    hash = hash_combine(hash, OS.str());
+    for (const Instruction &I : instructions(F)) {
+        text.clear();
+        I.print(OS, MST);
+        OS.flush();
+        std::string stripped;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '!' && i + 1 < text.size() && isdigit(static_cast<unsigned char>(text[i + 1]))) {
+                while (i + 1 < text.size() && isdigit(static_cast<unsigned char>(text[i + 1]))) {
+                    ++i;
+                }
+                continue;
+            }
+            stripped.push_back(text[i]);
+        }
+        hash = hash_combine(hash, stripped);
+        if (const DebugLoc &loc = I.getDebugLoc()) {
+            hash = hash_combine(hash, loc.getLine(), loc.getCol());
+        }
+        if (const auto *DVI = dyn_cast<DbgVariableIntrinsic>(&I)) {
+            if (const DILocalVariable *var = DVI->getVariable()) {
+                hash = hash_combine(hash, var->getName(), var->getLine());
+            }
+        }
+        if (const MDNode *weights = I.getMetadata(LLVMContext::MD_prof)) {
+            for (const MDOperand &operand : weights->operands()) {
+                if (const auto *weight = mdconst::dyn_extract<ConstantInt>(operand)) {
+                    hash = hash_combine(hash, weight->getZExtValue());
+                }
+            }
+        }
+    }
+    if (auto count = F.getEntryCount()) {
+        hash = hash_combine(hash, count->getCount());
+    }
+    return hash;
+}
+
+namespace {
+
+    // The functions defined in M whose code the report of each function reads directly: the summaries of its callees
+    // and of the targets of its indirect calls, and the stores of the functions writing the globals it loads, which
+    // the global input summary follows.
+    DenseMap<const Function *, SetVector<const Function *>> analysisDependencies(Module &M,
+                                                                                const IndirectCallTargets &indirectCalls) {
+        auto writableGlobal = [](const Value *pointer) {
+            auto *GV = dyn_cast<GlobalVariable>(getUnderlyingObject(pointer));
+            return GV && !GV->isConstant() ? GV : nullptr;
+        };
+        DenseMap<const GlobalVariable *, SetVector<const Function *>> writers;
+        DenseMap<const Function *, SetVector<const GlobalVariable *>> loads;
+        DenseMap<const Function *, SetVector<const Function *>> dependencies;
+        for (Function &F : M) {
+            if (F.isDeclaration()) {
+                continue;
+            }
+            SetVector<const Function *> &callees = dependencies[&F];
+            for (Instruction &I : instructions(F)) {
+                if (auto *Load = dyn_cast<LoadInst>(&I)) {
+                    if (const GlobalVariable *GV = writableGlobal(Load->getPointerOperand())) {
+                        loads[&F].insert(GV);
+                    }
+                } else if (auto *SI = dyn_cast<StoreInst>(&I)) {
+                    if (const GlobalVariable *GV = writableGlobal(SI->getPointerOperand())) {
+                        writers[GV].insert(&F);
+                    }
+                } else if (auto *CB = dyn_cast<CallBase>(&I)) {
+                    if (isa<DbgInfoIntrinsic>(CB)) {
+                        continue;
+                    }
+                    for (Value *arg : CB->args()) {
+                        if (const GlobalVariable *GV = arg->getType()->isPointerTy() ? writableGlobal(arg) : nullptr) {
+                            writers[GV].insert(&F);
+                        }
+                    }
+                    if (const Function *callee = CB->getCalledFunction()) {
+                        if (!callee->isDeclaration()) {
+                            callees.insert(callee);
+                        }
+                    } else if (const IndirectCallInfo *dispatch = indirectCalls.lookup(CB)) {
+                        for (const Function *target : dispatch->targets) {
+                            if (!target->isDeclaration()) {
+                                callees.insert(target);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        for (auto &entry : loads) {
+            for (const GlobalVariable *GV : entry.second) {
+                auto it = writers.find(GV);
+                if (it != writers.end()) {
+                    dependencies[entry.first].insert(it->second.begin(), it->second.end());
+                }
+            }
+        }
+        return dependencies;
+    }
+
+}  // end of anonymous namespace
+
+/**
+ * Function: hashModuleFunctions
+ *
+ * Description:
+ * Hashes every defined function of M on its own, then combines the hash of each function with the sorted hashes of
+ * the functions it transitively depends on (see analysisDependencies). A change in a callee, a new target of an
+ * indirect call or a new writer of a global then changes the hash of every function whose report may see it.
+ */
+
+std::vector<std::pair<std::string, uint64_t>> llvm::hashModuleFunctions(Module &M,
+                                                                        const IndirectCallTargets *indirectCalls) {
+    std::optional<IndirectCallTargets> ownTargets;
+    if (!indirectCalls) {
+        indirectCalls = &ownTargets.emplace(M);
+    }
+    DenseMap<const Function *, uint64_t> own;
+    ModuleSlotTracker MST(&M);
+    for (Function &F : M) {
+        if (!F.isDeclaration()) {
+            MST.incorporateFunction(F);
+            own[&F] = hashFunctionForAnalysis(F, MST);
+        }
+    }
+    DenseMap<const Function *, SetVector<const Function *>> dependencies = analysisDependencies(M, *indirectCalls);
+
+    std::vector<std::pair<std::string, uint64_t>> hashes;
+    for (Function &F : M) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        SmallPtrSet<const Function *, 16> reached{&F};
+        SmallVector<const Function *, 16> worklist{&F};
+        std::vector<uint64_t> dependencyHashes;
+        while (!worklist.empty()) {
+            for (const Function *dependency : dependencies[worklist.pop_back_val()]) {
+                if (reached.insert(dependency).second) {
+                    worklist.push_back(dependency);
+                    dependencyHashes.push_back(own[dependency]);
+                }
+            }
+        }
+        llvm::sort(dependencyHashes);
+        hash_code hash = hash_combine(own[&F], hash_combine_range(dependencyHashes.begin(), dependencyHashes.end()));
+        hashes.emplace_back(F.getName().str(), hash);
+    }
+    return hashes;
+}
+
+namespace {
+
+    // The feature -> loop edges of a report: the reported variables each loop condition reads.
+    std::vector<LoopEdges> loopEdges(const SeminalFunctionReport &report) {
+        std::vector<LoopEdges> loops;
+        for (const SeminalControlPointReport &loop : report.loops) {
+            LoopEdges entry;
+            entry.line = loop.line;
+            entry.depth = loop.loopDepth;
+            for (const SeminalVariableReport &variable : report.variables) {
+                if (!is_contained(loop.variables, variable.name)) {
+                    continue;
+                }
+                FeatureEdge edge;
+                edge.feature = variable.name;
+                edge.fromInput = variable.kind == SeminalFeatureKind::IO;
+                edge.inputLines = variable.inputLines;
+                for (const SeminalInputCallReport &call : report.inputCalls) {
+                    if (is_contained(variable.inputLines, call.line)) {
+                        edge.inputs.push_back(call.callee);
+                    }
+                }
+                llvm::sort(edge.inputs);
+                edge.inputs.erase(std::unique(edge.inputs.begin(), edge.inputs.end()), edge.inputs.end());
+                entry.edges.push_back(std::move(edge));
+            }
+            llvm::sort(entry.edges, [](const FeatureEdge &a, const FeatureEdge &b) { return a.feature < b.feature; });
+            loops.push_back(std::move(entry));
+        }
+        return loops;
+    }
+
+    Json edgeToJson(const FeatureEdge &edge) {
+        Json edgeJson;
+        edgeJson["feature"] = edge.feature;
+        edgeJson["type"] = edge.fromInput ? "IO" : "Potential";
+        edgeJson["inputs"] = edge.inputs;
+        edgeJson["input_lines"] = edge.inputLines;
+        return edgeJson;
+    }
+
+    template <typename T> T field(const Json &object, const char *key, T otherwise) {
+        auto it = object.find(key);
+        if (it == object.end()) {
+            return otherwise;
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            return it->is_boolean() ? it->template get<bool>() : otherwise;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return it->is_string() ? it->template get<std::string>() : otherwise;
+        } else {
+            return it->is_number_unsigned() ? it->template get<T>() : otherwise;
+        }
+    }
+
+    FeatureEdge edgeFromJson(const Json &edgeJson) {
+        FeatureEdge edge;
+        edge.feature = field<std::string>(edgeJson, "feature", "");
+        edge.fromInput = field<std::string>(edgeJson, "type", "") == "IO";
+        auto inputs = edgeJson.find("inputs");
+        if (inputs != edgeJson.end() && inputs->is_array()) {
+            for (const auto &input : *inputs) {
+                if (input.is_string()) {
+                    edge.inputs.push_back(input.get<std::string>());
+                }
+            }
+        }
+        auto lines = edgeJson.find("input_lines");
+        if (lines != edgeJson.end() && lines->is_array()) {
+            for (const auto &line : *lines) {
+                if (line.is_number_unsigned()) {
+                    edge.inputLines.push_back(line.get<unsigned>());
+                }
+            }
+        }
+        return edge;
+    }
+
+}  // end of anonymous namespace
+
+bool FeatureEdgeIndex::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        errs() << "Cannot open edge index " << path << "\n";
+        return false;
+    }
+    Json indexJson = Json::parse(file, nullptr, /*allow_exceptions=*/false);
+    if (indexJson.is_discarded() || !indexJson.is_object() || !indexJson.contains("functions") ||
+        !indexJson["functions"].is_array()) {
+        errs() << "Malformed edge index " << path << "\n";
+        return false;
+    }
+    for (const auto &functionJson : indexJson["functions"]) {
+        if (!functionJson.is_object()) {
+            continue;
+        }
+        FunctionEdges function;
+        function.function = field<std::string>(functionJson, "function", "");
+        function.hash = field<uint64_t>(functionJson, "hash", 0);
+        function.shapeHash = field<uint64_t>(functionJson, "shape_hash", 0);
+        function.analyzed = field<bool>(functionJson, "analyzed", true);
+        auto loops = functionJson.find("loops");
+        if (loops != functionJson.end() && loops->is_array()) {
+            for (const auto &loopJson : *loops) {
+                if (!loopJson.is_object()) {
+                    continue;
+                }
+                LoopEdges loop;
+                loop.line = field<unsigned>(loopJson, "line", 0);
+                loop.depth = field<unsigned>(loopJson, "depth", 0);
+                auto edges = loopJson.find("edges");
+                if (edges != loopJson.end() && edges->is_array()) {
+                    for (const auto &edgeJson : *edges) {
+                        if (edgeJson.is_object()) {
+                            loop.edges.push_back(edgeFromJson(edgeJson));
+                        }
+                    }
+                }
+                llvm::sort(loop.edges, [](const FeatureEdge &a, const FeatureEdge &b) { return a.feature < b.feature; });
+                function.loops.push_back(std::move(loop));
+            }
+        }
+        functions.push_back(std::move(function));
+    }
+    return true;
+}
+
+Json FeatureEdgeIndex::toJson() const {
+    Json functionsJson = Json::array();
+    for (const FunctionEdges &function : functions) {
+        Json functionJson;
+        functionJson["function"] = function.function;
+        functionJson["hash"] = function.hash;
+        functionJson["shape_hash"] = function.shapeHash;
+        if (!function.analyzed) {
+            functionJson["analyzed"] = false;
+        }
+        Json loopsJson = Json::array();
+        for (const LoopEdges &loop : function.loops) {
+            Json edgesJson = Json::array();
+            for (const FeatureEdge &edge : loop.edges) {
+                edgesJson.push_back(edgeToJson(edge));
+            }
+            loopsJson.push_back({{"line", loop.line}, {"depth", loop.depth}, {"edges", std::move(edgesJson)}});
+        }
+        functionJson["loops"] = std::move(loopsJson);
+        functionsJson.push_back(std::move(functionJson));
+    }
+    Json indexJson;
+    indexJson["functions"] = std::move(functionsJson);
+    return indexJson;
+}
+
+FeatureEdgeIndex llvm::buildFeatureEdgeIndex(Module &M, const FeatureSummaryIndex *summaries,
+                                             function_ref<bool(StringRef, uint64_t)> needsEdges) {
+    SeminalAnalysisManagers analyses(summaries);
+    analyses.prepare(M);
+
+    FeatureEdgeIndex index;
+    std::vector<std::pair<std::string, uint64_t>> hashes =
+        hashModuleFunctions(M, &analyses.MAM.getResult<IndirectCallAnalysis>(M));
+    size_t next = 0;
+    for (Function &F : M) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        FunctionEdges function;
+        function.function = F.getName().str();
+        function.hash = hashes[next++].second;
+        function.shapeHash = FunctionComparator::functionHash(F);
+        if (needsEdges(F.getName(), function.hash)) {
+            function.analyzed = true;
+            function.loops = loopEdges(reportFunction(F, analyses.FAM.getResult<SeminalFeatureAnalysis>(F)));
+        }
+        index.functions.push_back(std::move(function));
+    }
+    return index;
+}
+
+namespace {
+
+    // Appends the loop entry for one matched (or unmatched, when one side is null) loop, if any of its edges changed.
+    void diffLoop(const LoopEdges *before, const LoopEdges *after, Json &loopsJson) {
+        static const std::vector<FeatureEdge> none;
+        const std::vector<FeatureEdge> &oldEdges = before ? before->edges : none;
+        const std::vector<FeatureEdge> &newEdges = after ? after->edges : none;
+        Json added = Json::array(), removed = Json::array(), changed = Json::array();
+        size_t i = 0, j = 0;
+        while (i < oldEdges.size() || j < newEdges.size()) {
+            if (j == newEdges.size() || (i < oldEdges.size() && oldEdges[i].feature < newEdges[j].feature)) {
+                removed.push_back(edgeToJson(oldEdges[i++]));
+            } else if (i == oldEdges.size() || newEdges[j].feature < oldEdges[i].feature) {
+                added.push_back(edgeToJson(newEdges[j++]));
+            } else {
+                const FeatureEdge &oldEdge = oldEdges[i++], &newEdge = newEdges[j++];
+                // Input lines alone move with unrelated edits above the call; what drives the loop is the input.
+                if (oldEdge.fromInput != newEdge.fromInput || oldEdge.inputs != newEdge.inputs) {
+                    changed.push_back(
+                        {{"feature", newEdge.feature}, {"before", edgeToJson(oldEdge)}, {"after", edgeToJson(newEdge)}});
+                }
+            }
+        }
+        if (added.empty() && removed.empty() && changed.empty()) {
+            return;
+        }
+        Json loopJson;
+        if (after) {
+            loopJson["line"] = after->line;
+        }
+        if (before) {
+            loopJson["before_line"] = before->line;
+        }
+        loopJson["depth"] = after ? after->depth : before->depth;
+        loopJson["added"] = std::move(added);
+        loopJson["removed"] = std::move(removed);
+        loopJson["changed"] = std::move(changed);
+        loopsJson.push_back(std::move(loopJson));
+    }
+
+    /**
+     * Function: diffFunction
+     *
+     * Description:
+     * Matches the loops of two versions of a function and diffs the edges of each pair. Loops are matched by start line
+     * and depth first; the remaining ones, typically moved by edits above them, are paired in loop order among loops of
+     * the same depth. Loops left without a partner contribute all their edges as added or removed. Either version may be
+     * null for an added or removed function.
+     */
+
+    Json diffFunction(const FunctionEdges *before, const FunctionEdges *after) {
+        static const std::vector<LoopEdges> none;
+        const std::vector<LoopEdges> &oldLoops = before ? before->loops : none;
+        const std::vector<LoopEdges> &newLoops = after ? after->loops : none;
+        std::vector<int> partner(newLoops.size(), -1);
+        std::vector<bool> taken(oldLoops.size(), false);
+        auto match = [&](function_ref<bool(const LoopEdges &, const LoopEdges &)> same) {
+            for (size_t i = 0; i < newLoops.size(); ++i) {
+                for (size_t j = 0; partner[i] < 0 && j < oldLoops.size(); ++j) {
+                    if (!taken[j] && same(oldLoops[j], newLoops[i])) {
+                        partner[i] = j;
+                        taken[j] = true;
+                    }
+                }
+            }
+        };
+        match([](const LoopEdges &a, const LoopEdges &b) { return a.line == b.line && a.depth == b.depth; });
+        match([](const LoopEdges &a, const LoopEdges &b) { return a.depth == b.depth; });
+
+        Json loopsJson = Json::array();
+        for (size_t i = 0; i < newLoops.size(); ++i) {
+            diffLoop(partner[i] < 0 ? nullptr : &oldLoops[partner[i]], &newLoops[i], loopsJson);
+        }
+        for (size_t j = 0; j < oldLoops.size(); ++j) {
+            if (!taken[j]) {
+                diffLoop(&oldLoops[j], nullptr, loopsJson);
+            }
+        }
+        return loopsJson;
+    }
+
+}  // end of anonymous namespace
+
+    /**
+     * Function: diffFeatureEdges
+     *
+     * Description:
+     * Pairs the functions of the two versions by name; a pair with equal hashes is skipped without looking at its edges.
+     * Functions found in only one version are then paired by shape hash, in module order, so a renamed function is
+     * diffed against its old self instead of being reported as removed and re-added.
+     *
+     * Output:
+     * - One entry per function with changed edges: its name, a status (changed, renamed, added or removed), the name
+     *   it had before when renamed, and the loops whose edges changed.
+     */
+
+Json llvm::diffFeatureEdges(const FeatureEdgeIndex &before, const FeatureEdgeIndex &after) {
+    StringMap<const FunctionEdges *> oldByName;
+    for (const FunctionEdges &function : before.functions) {
+        oldByName[function.function] = &function;
+    }
+    StringMap<bool> newNames;
+    for (const FunctionEdges &function : after.functions) {
+        newNames[function.function] = true;
+    }
+
+    Json diffJson = Json::array();
+    auto report = [&](const FunctionEdges *oldFunction, const FunctionEdges *newFunction, const char *status) {
+        Json loopsJson = diffFunction(oldFunction, newFunction);
+        if (loopsJson.empty()) {
+            return;
+        }
+        Json functionJson;
+        functionJson["function"] = newFunction ? newFunction->function : oldFunction->function;
+        functionJson["status"] = status;
+        if (oldFunction && newFunction && oldFunction->function != newFunction->function) {
+            functionJson["before_function"] = oldFunction->function;
+        }
+        functionJson["loops"] = std::move(loopsJson);
+        diffJson.push_back(std::move(functionJson));
+    };
+
+    std::vector<const FunctionEdges *> oldUnmatched, newUnmatched;
+    for (const FunctionEdges &function : before.functions) {
+        if (!newNames.count(function.function)) {
+            oldUnmatched.push_back(&function);
+        }
+    }
+    for (const FunctionEdges &function : after.functions) {
+        const FunctionEdges *old = oldByName.lookup(function.function);
+        if (!old) {
+            newUnmatched.push_back(&function);
+        } else if (old->hash != function.hash) {
+            report(old, &function, "changed");
+        }
+    }
+    for (const FunctionEdges *function : newUnmatched) {
+        auto old = find_if(oldUnmatched, [&](const FunctionEdges *candidate) {
+            return candidate && candidate->shapeHash == function->shapeHash;
+        });
+        if (old != oldUnmatched.end()) {
+            report(*old, function, "renamed");
+            *old = nullptr;
+        } else {
+            report(nullptr, function, "added");
+        }
+    }
+    for (const FunctionEdges *function : oldUnmatched) {
+        if (function) {
+            report(function, nullptr, "removed");
+        }
+    }
+    return diffJson;
+}
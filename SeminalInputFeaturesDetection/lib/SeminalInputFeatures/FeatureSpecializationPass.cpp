@@ -0,0 +1,272 @@
+#include "SeminalInputFeatures/FeatureSpecializationPass.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <vector>
+using namespace llvm;
+using Json = nlohmann::json;
+
+static cl::opt<std::string> ValueProfileFile(
+    "seminal-value-profile",
+    cl::desc("JSON value profile of seminal input features, read by seminal-specialize"),
+    cl::value_desc("filename"));
+
+static cl::opt<unsigned> MaxSpecializedValues(
+    "seminal-spec-max-values", cl::init(2),
+    cl::desc("Maximum number of hot values each feature is specialized on"));
+
+static cl::opt<double> MinValueFraction(
+    "seminal-spec-min-fraction", cl::init(0.1),
+    cl::desc("Minimum fraction of the profiled executions a value must cover to be specialized"));
+
+namespace {
+
+struct ValueCount {
+    int64_t value;
+    uint64_t count;
+};
+
+struct FeatureProfile {
+    std::string function;
+    std::string variable;
+    std::vector<ValueCount> values;
+};
+
+    /**
+     * Function: loadValueProfile
+     *
+     * Description:
+     * Reads the value profile of the seminal input features. The file uses the same function/variable naming as
+     * influential_variables.json, so the features reported by def-use-analysis can be profiled directly:
+     *   [ { "function": "process", "variable": "n", "values": [ { "value": 64, "count": 9000 }, ... ] }, ... ]
+     *
+     * Output:
+     * - One FeatureProfile per well-formed entry. Malformed entries are skipped; an unreadable file yields no entries.
+     */
+
+    std::vector<FeatureProfile> loadValueProfile(const std::string &path) {
+        std::vector<FeatureProfile> profiles;
+        std::ifstream file(path);
+        if (!file) {
+            errs() << "Cannot open value profile " << path << "\n";
+            return profiles;
+        }
+        Json profileJson = Json::parse(file, nullptr, /*allow_exceptions=*/false);
+        if (profileJson.is_discarded() || !profileJson.is_array()) {
+            errs() << "Malformed value profile " << path << "\n";
+            return profiles;
+        }
+
+        for (const auto &entry : profileJson) {
+            if (!entry.is_object() || !entry.contains("function") || !entry.contains("variable") ||
+                !entry["function"].is_string() || !entry["variable"].is_string() ||
+                !entry.contains("values") || !entry["values"].is_array()) {
+                continue;
+            }
+            FeatureProfile profile;
+            profile.function = entry["function"].get<std::string>();
+            profile.variable = entry["variable"].get<std::string>();
+            for (const auto &valueJson : entry["values"]) {
+                if (!valueJson.is_object() || !valueJson.contains("value") || !valueJson.contains("count") ||
+                    !valueJson["value"].is_number_integer() || !valueJson["count"].is_number_integer()) {
+                    continue;
+                }
+                profile.values.push_back({valueJson["value"].get<int64_t>(), valueJson["count"].get<uint64_t>()});
+            }
+            profiles.push_back(profile);
+        }
+        return profiles;
+    }
+
+    // Returns the most frequent values, hottest first, that each cover at least MinValueFraction of the profile.
+    // Entries repeating a value are summed first, so each value gets at most one clone.
+    std::vector<ValueCount> selectHotValues(const std::vector<ValueCount> &profiled) {
+        std::map<int64_t, uint64_t> counts;
+        uint64_t total = 0;
+        for (const ValueCount &vc : profiled) {
+            counts[vc.value] += vc.count;
+            total += vc.count;
+        }
+        std::vector<ValueCount> values;
+        for (const auto &entry : counts) {
+            values.push_back({entry.first, entry.second});
+        }
+        std::stable_sort(values.begin(), values.end(),
+                         [](const ValueCount &a, const ValueCount &b) { return a.count > b.count; });
+
+        std::vector<ValueCount> hot;
+        for (const ValueCount &vc : values) {
+            if (hot.size() >= MaxSpecializedValues || total == 0 || vc.count < MinValueFraction * total) {
+                break;
+            }
+            hot.push_back(vc);
+        }
+        return hot;
+    }
+
+    /**
+     * Function: findFeatureArgument
+     *
+     * Description:
+     * Maps a seminal feature name back to the formal parameter of F that carries it. The debug variable of a parameter
+     * records its argument number, which is used first, whether its location is a dbg.declare, a dbg.value or (from
+     * LLVM 19) a debug record; SSA argument names are the fallback for IR without debug info.
+     *
+     * Output:
+     * - The matching Argument, or nullptr when the feature is a local of F rather than one of its parameters.
+     */
+
+    Argument *findFeatureArgument(Function &F, StringRef varName) {
+        auto parameter = [&](const DILocalVariable *Var) -> Argument * {
+            if (Var && Var->getName() == varName && Var->getArg() > 0 && Var->getArg() <= F.arg_size()) {
+                return F.getArg(Var->getArg() - 1);
+            }
+            return nullptr;
+        };
+        for (Instruction &I : instructions(F)) {
+#if LLVM_VERSION_MAJOR >= 19
+            for (DbgVariableRecord &DVR : filterDbgVars(I.getDbgRecordRange())) {
+                if (Argument *A = parameter(DVR.getVariable())) {
+                    return A;
+                }
+            }
+#endif
+            if (auto *DVI = dyn_cast<DbgVariableIntrinsic>(&I)) {
+                if (Argument *A = parameter(DVI->getVariable())) {
+                    return A;
+                }
+            }
+        }
+        for (Argument &A : F.args()) {
+            if (A.getName() == varName) {
+                return &A;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Function: specializeFunction
+     *
+     * Description:
+     * Clones F once per hot value with the feature parameter replaced by that constant, so loops bounded by the
+     * feature get constant trip counts in the clones. The entry block of F is then split after its allocas and a
+     * chain of equality checks forwards matching calls to the corresponding clone; all other values fall through
+     * to the original body.
+     *
+     * Output:
+     * - Returns true if at least one clone was created and F was rewritten.
+     */
+
+    bool specializeFunction(Function &F, Argument &featureArg, StringRef variable, const std::vector<ValueCount> &hotValues) {
+        LLVMContext &Ctx = F.getContext();
+        auto *argType = cast<IntegerType>(featureArg.getType());
+
+        // Clone before touching F so the clones do not contain the dispatch.
+        std::vector<std::pair<ConstantInt *, Function *>> clones;
+        for (const ValueCount &vc : hotValues) {
+            ConstantInt *constant = ConstantInt::get(argType, vc.value, /*isSigned=*/true);
+            if (constant->getSExtValue() != vc.value) {
+                continue;
+            }
+            ValueToValueMapTy VMap;
+            VMap[&featureArg] = constant;
+            Function *clone = CloneFunction(&F, VMap);
+            clone->setName(F.getName() + ".seminal." + Twine(vc.value));
+            clone->setVisibility(GlobalValue::DefaultVisibility);
+            clone->setDLLStorageClass(GlobalValue::DefaultStorageClass);
+            clone->setLinkage(GlobalValue::InternalLinkage);
+            clone->setComdat(nullptr);
+            clones.push_back({constant, clone});
+            errs() << "Specialized " << F.getName() << " on " << variable << " = " << vc.value
+                   << " as " << clone->getName() << "\n";
+        }
+        if (clones.empty()) {
+            return false;
+        }
+
+        BasicBlock *entry = &F.getEntryBlock();
+        BasicBlock::iterator splitPoint = entry->begin();
+        while (isa<AllocaInst>(*splitPoint)) {
+            ++splitPoint;
+        }
+        BasicBlock *body = SplitBlock(entry, &*splitPoint);
+        entry->getTerminator()->eraseFromParent();
+
+        SmallVector<Value *, 8> forwardedArgs;
+        for (Argument &A : F.args()) {
+            if (&A != &featureArg) {
+                forwardedArgs.push_back(&A);
+            }
+        }
+
+        IRBuilder<> Builder(entry);
+        if (DISubprogram *SP = F.getSubprogram()) {
+            Builder.SetCurrentDebugLocation(DILocation::get(Ctx, SP->getScopeLine(), 0, SP));
+        }
+        BasicBlock *current = entry;
+        for (size_t i = 0; i < clones.size(); ++i) {
+            BasicBlock *specBlock = BasicBlock::Create(Ctx, "seminal.spec", &F, body);
+            BasicBlock *next = i + 1 == clones.size() ? body : BasicBlock::Create(Ctx, "seminal.dispatch", &F, body);
+
+            Builder.SetInsertPoint(current);
+            Builder.CreateCondBr(Builder.CreateICmpEQ(&featureArg, clones[i].first), specBlock, next);
+
+            Builder.SetInsertPoint(specBlock);
+            CallInst *call = Builder.CreateCall(clones[i].second, forwardedArgs);
+            call->setCallingConv(F.getCallingConv());
+            if (F.getReturnType()->isVoidTy()) {
+                Builder.CreateRetVoid();
+            } else {
+                Builder.CreateRet(call);
+            }
+            current = next;
+        }
+        return true;
+    }
+
+}  // end of anonymous namespace
+
+PreservedAnalyses FeatureSpecializationPass::run(Module &M, ModuleAnalysisManager &) {
+    if (ValueProfileFile.empty()) {
+        errs() << "seminal-specialize: no value profile given (-seminal-value-profile)\n";
+        return PreservedAnalyses::all();
+    }
+
+    bool changed = false;
+    for (const FeatureProfile &profile : loadValueProfile(ValueProfileFile)) {
+        Function *F = M.getFunction(profile.function);
+        if (!F || F->isDeclaration() || F->isVarArg()) {
+            continue;
+        }
+        // optnone bodies are never unrolled or vectorized, so a clone would only add code.
+        if (F->hasOptNone()) {
+            errs() << "Skipping specialization of optnone function " << F->getName() << "\n";
+            continue;
+        }
+        Argument *featureArg = findFeatureArgument(*F, profile.variable);
+        if (!featureArg || !featureArg->getType()->isIntegerTy()) {
+            errs() << "Feature " << profile.variable << " is not an integer parameter of " << F->getName()
+                   << ", not specializing\n";
+            continue;
+        }
+        std::vector<ValueCount> hotValues = selectHotValues(profile.values);
+        if (hotValues.empty()) {
+            continue;
+        }
+        changed |= specializeFunction(*F, *featureArg, profile.variable, hotValues);
+    }
+    return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
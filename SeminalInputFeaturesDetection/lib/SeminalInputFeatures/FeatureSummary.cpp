@@ -0,0 +1,784 @@
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include <fstream>
+using namespace llvm;
+using Json = nlohmann::json;
+
+namespace {
+
+// Backward data dependences of a function, through registers and through the
+// memory objects written by stores and calls.
+class BackwardSlicer {
+public:
+    explicit BackwardSlicer(Function &F) {
+        for (Instruction &I : instructions(F)) {
+            if (auto *SI = dyn_cast<StoreInst>(&I)) {
+                writers[getUnderlyingObject(SI->getPointerOperand())].push_back(SI->getValueOperand());
+            } else if (auto *CI = dyn_cast<CallBase>(&I)) {
+                if (isa<DbgInfoIntrinsic>(CI)) {
+                    continue;
+                }
+                for (Value *arg : CI->args()) {
+                    if (arg->getType()->isPointerTy()) {
+                        writers[getUnderlyingObject(arg)].push_back(CI);
+                    }
+                }
+            }
+        }
+    }
+
+    // Calls visit on every value the roots transitively depend on, roots included.
+    template <typename Fn> void slice(ArrayRef<Value *> roots, Fn visit) const {
+        SmallPtrSet<Value *, 32> visited;
+        SmallVector<Value *, 32> worklist(roots.begin(), roots.end());
+        while (!worklist.empty()) {
+            Value *V = worklist.pop_back_val();
+            if ((isa<Constant>(V) && !isa<GlobalVariable>(V)) || !visited.insert(V).second) {
+                continue;
+            }
+            visit(V);
+            auto it = writers.find(V);
+            if (it != writers.end()) {
+                worklist.append(it->second.begin(), it->second.end());
+            }
+            if (auto *CI = dyn_cast<CallBase>(V)) {
+                worklist.append(CI->arg_begin(), CI->arg_end());
+            } else if (auto *I = dyn_cast<Instruction>(V)) {
+                worklist.append(I->op_begin(), I->op_end());
+            }
+        }
+    }
+
+    // The parameter V refers to, looking through the allocas -O0 spills parameters into.
+    const Argument *parameterOf(Value *V) const {
+        V = getUnderlyingObject(V);
+        if (auto *A = dyn_cast<Argument>(V)) {
+            return A;
+        }
+        if (auto *Load = dyn_cast<LoadInst>(V)) {
+            auto it = writers.find(getUnderlyingObject(Load->getPointerOperand()));
+            if (it != writers.end() && it->second.size() == 1) {
+                return dyn_cast<Argument>(it->second.front());
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    DenseMap<const Value *, SmallVector<Value *, 2>> writers;
+};
+
+    bool isSummarizedCallee(const Function *callee) {
+        return callee && !callee->isIntrinsic() && !callee->hasLocalLinkage() && !isInputFunction(callee);
+    }
+
+    // The callees of CI the global merge resolves by name: its callee, or the targets of a call through a pointer.
+    SmallVector<const Function *, 2> summarizedCallees(const CallBase *CI, const IndirectCallTargets *indirectCalls) {
+        SmallVector<const Function *, 2> callees;
+        if (const Function *callee = CI->getCalledFunction()) {
+            callees.push_back(callee);
+        } else if (const IndirectCallInfo *dispatch = indirectCalls ? indirectCalls->lookup(CI) : nullptr) {
+            callees.append(dispatch->targets.begin(), dispatch->targets.end());
+        }
+        llvm::erase_if(callees, [](const Function *callee) { return !isSummarizedCallee(callee); });
+        return callees;
+    }
+
+    // What summarizeFunction cannot tell from F alone, when F is summarized for one of its call strings. Exported
+    // summaries are computed without it: callees other than the input functions are left to the global merge, and no
+    // parameter carries input.
+    struct SummaryContext {
+        function_ref<const FunctionFeatureSummary *(const CallBase *)> calleeSummary;
+        const std::set<unsigned> &inputParams;
+    };
+
+    // Whether the result of CI, or the memory it writes, comes from input.
+    bool callReadsInput(const CallBase *CI, const SummaryContext *context) {
+        if (isInputFunction(CI->getCalledFunction())) {
+            return true;
+        }
+        const FunctionFeatureSummary *summary = context ? context->calleeSummary(CI) : nullptr;
+        return summary && (summary->returnsInput || !summary->inputParams.empty());
+    }
+
+    bool isInputParam(const Value *V, const SummaryContext *context) {
+        const auto *A = dyn_cast<Argument>(V);
+        return A && context && context->inputParams.count(A->getArgNo());
+    }
+
+    // Context-free summaries of the functions with local linkage of a module, computed bottom-up on first use. The
+    // global merge resolves callees by name, which a static helper does not have outside its module, so an exported
+    // function folds the summaries of the helpers it calls into its own. A helper reached again while it is being
+    // summarized (recursion) contributes nothing.
+    class LocalSummaries {
+    public:
+        LocalSummaries(function_ref<LoopInfo &(Function &)> getLoopInfo, const IndirectCallTargets *indirectCalls)
+            : getLoopInfo(getLoopInfo), indirectCalls(indirectCalls) {}
+
+        // The summary of CI's callee, when it is a function with local linkage defined in the module.
+        const FunctionFeatureSummary *lookup(const CallBase *CI);
+
+    private:
+        function_ref<LoopInfo &(Function &)> getLoopInfo;
+        const IndirectCallTargets *indirectCalls;
+        std::map<const Function *, FunctionFeatureSummary> summaries;
+    };
+
+    /**
+     * Function: summarizeFunction
+     *
+     * Description:
+     * Computes the taint summary of F as seen by its callers:
+     * - inputParams: pointer parameters handed to an input function, or stored through with a value sliced back to input;
+     * - returnsInput / returnCalls: whether the backward slice of the returned values reaches an input call, and which
+     *   external calls it reaches (resolved later by the global merge);
+     * - loopParams: parameters in the backward slice of a loop exit condition.
+     * Under a context, the calls F makes are resolved to the summaries it gives, and the parameters it marks carry
+     * input like an input call does. Without one, the targets 'indirectCalls' knows for calls through pointers are
+     * left to the global merge like direct callees, with the parameters of F each argument passes on (pointerArgs,
+     * valueArgs), so that the merge carries the callee's inputParams and loopParams over to F. The summaries 'locals'
+     * gives for calls of static helpers are folded into F's, their parameters and edges mapped to those of F through
+     * the arguments of the call.
+     */
+
+    FunctionFeatureSummary summarizeFunction(Function &F, LoopInfo &LI, const BackwardSlicer &slicer,
+                                             const SummaryContext *context = nullptr,
+                                             const IndirectCallTargets *indirectCalls = nullptr,
+                                             LocalSummaries *locals = nullptr) {
+        FunctionFeatureSummary summary;
+
+        // The parameters of F an argument is computed from.
+        auto argumentSources = [&](Value *arg) {
+            SmallVector<unsigned, 2> sources;
+            slicer.slice(arg, [&](Value *V) {
+                if (auto *A = dyn_cast<Argument>(V)) {
+                    sources.push_back(A->getArgNo());
+                }
+            });
+            return sources;
+        };
+        auto localSummary = [&](const CallBase *CI) { return locals ? locals->lookup(CI) : nullptr; };
+        auto returnsInput = [&](const CallBase *CI) {
+            const FunctionFeatureSummary *local = localSummary(CI);
+            return callReadsInput(CI, context) || (local && local->returnsInput);
+        };
+
+        auto slicedFromInput = [&](Value *root) {
+            bool fromInput = false;
+            slicer.slice(root, [&](Value *V) {
+                if (auto *CI = dyn_cast<CallBase>(V)) {
+                    fromInput |= returnsInput(CI);
+                } else {
+                    fromInput |= isInputParam(V, context);
+                }
+            });
+            return fromInput;
+        };
+
+        SmallVector<Value *, 4> returnedValues;
+        for (Instruction &I : instructions(F)) {
+            if (auto *CI = dyn_cast<CallBase>(&I)) {
+                Function *callee = CI->getCalledFunction();
+                if (isInputFunction(callee)) {
+                    summary.readsInput = true;
+                    for (Value *arg : CI->args()) {
+                        if (const Argument *A = slicer.parameterOf(arg)) {
+                            summary.inputParams.insert(A->getArgNo());
+                        }
+                    }
+                } else if (const FunctionFeatureSummary *calleeSummary = context ? context->calleeSummary(CI) : nullptr) {
+                    summary.readsInput |= calleeSummary->readsInput;
+                    for (unsigned argNo : calleeSummary->inputParams) {
+                        const Argument *A = argNo < CI->arg_size() ? slicer.parameterOf(CI->getArgOperand(argNo)) : nullptr;
+                        if (A) {
+                            summary.inputParams.insert(A->getArgNo());
+                        }
+                    }
+                } else if (const FunctionFeatureSummary *local = localSummary(CI)) {
+                    summary.readsInput |= local->readsInput;
+                    summary.calls.insert(local->calls.begin(), local->calls.end());
+                    auto pointerParam = [&](unsigned argNo) -> const Argument * {
+                        return argNo < CI->arg_size() ? slicer.parameterOf(CI->getArgOperand(argNo)) : nullptr;
+                    };
+                    auto valueParams = [&](unsigned argNo) {
+                        return argNo < CI->arg_size() ? argumentSources(CI->getArgOperand(argNo)) : SmallVector<unsigned, 2>();
+                    };
+                    for (unsigned argNo : local->inputParams) {
+                        if (const Argument *A = pointerParam(argNo)) {
+                            summary.inputParams.insert(A->getArgNo());
+                        }
+                    }
+                    for (unsigned argNo : local->loopParams) {
+                        for (unsigned param : valueParams(argNo)) {
+                            summary.loopParams.insert(param);
+                        }
+                    }
+                    for (const auto &edges : local->pointerArgs) {
+                        for (const auto &edge : edges.second) {
+                            if (const Argument *A = pointerParam(edge.second)) {
+                                summary.pointerArgs[edges.first].insert({edge.first, A->getArgNo()});
+                            }
+                        }
+                    }
+                    for (const auto &edges : local->valueArgs) {
+                        for (const auto &edge : edges.second) {
+                            for (unsigned param : valueParams(edge.second)) {
+                                summary.valueArgs[edges.first].insert({edge.first, param});
+                            }
+                        }
+                    }
+                } else {
+                    SmallVector<const Function *, 2> targets = summarizedCallees(CI, indirectCalls);
+                    for (const Function *target : targets) {
+                        summary.calls.insert(target->getName().str());
+                    }
+                    for (unsigned argNo = 0; argNo < CI->arg_size() && !targets.empty(); ++argNo) {
+                        Value *arg = CI->getArgOperand(argNo);
+                        const Argument *pointer = arg->getType()->isPointerTy() ? slicer.parameterOf(arg) : nullptr;
+                        SmallVector<unsigned, 2> sources = argumentSources(arg);
+                        for (const Function *target : targets) {
+                            std::string name = target->getName().str();
+                            if (pointer) {
+                                summary.pointerArgs[name].insert({argNo, pointer->getArgNo()});
+                            }
+                            for (unsigned param : sources) {
+                                summary.valueArgs[name].insert({argNo, param});
+                            }
+                        }
+                    }
+                }
+            } else if (auto *SI = dyn_cast<StoreInst>(&I)) {
+                const Argument *A = slicer.parameterOf(SI->getPointerOperand());
+                if (A && A->getType()->isPointerTy() && slicedFromInput(SI->getValueOperand())) {
+                    summary.inputParams.insert(A->getArgNo());
+                }
+            } else if (auto *RI = dyn_cast<ReturnInst>(&I)) {
+                if (Value *returned = RI->getReturnValue()) {
+                    returnedValues.push_back(returned);
+                }
+            }
+        }
+
+        slicer.slice(returnedValues, [&](Value *V) {
+            if (auto *CI = dyn_cast<CallBase>(V)) {
+                if (returnsInput(CI)) {
+                    summary.returnsInput = true;
+                } else if (const FunctionFeatureSummary *local = localSummary(CI)) {
+                    summary.returnCalls.insert(local->returnCalls.begin(), local->returnCalls.end());
+                } else {
+                    for (const Function *target : summarizedCallees(CI, indirectCalls)) {
+                        summary.returnCalls.insert(target->getName().str());
+                    }
+                }
+            } else if (isInputParam(V, context)) {
+                summary.returnsInput = true;
+            }
+        });
+
+        SmallVector<Value *, 8> exitConditions;
+        for (Loop *loop : LI.getLoopsInPreorder()) {
+            SmallVector<BasicBlock *, 4> exitingBlocks;
+            loop->getExitingBlocks(exitingBlocks);
+            for (BasicBlock *BB : exitingBlocks) {
+                if (auto *BI = dyn_cast<BranchInst>(BB->getTerminator())) {
+                    if (BI->isConditional()) {
+                        exitConditions.push_back(BI->getCondition());
+                    }
+                }
+            }
+        }
+        slicer.slice(exitConditions, [&](Value *V) {
+            if (auto *A = dyn_cast<Argument>(V)) {
+                summary.loopParams.insert(A->getArgNo());
+            }
+        });
+        return summary;
+    }
+
+    const FunctionFeatureSummary *LocalSummaries::lookup(const CallBase *CI) {
+        Function *callee = CI->getCalledFunction();
+        if (!callee || callee->isDeclaration() || !callee->hasLocalLinkage()) {
+            return nullptr;
+        }
+        auto inserted = summaries.try_emplace(callee);
+        if (inserted.second) {
+            inserted.first->second = summarizeFunction(*callee, getLoopInfo(*callee), BackwardSlicer(*callee), nullptr,
+                                                       indirectCalls, this);
+        }
+        return &inserted.first->second;
+    }
+
+    Json summaryToJson(const FunctionFeatureSummary &summary) {
+        Json summaryJson = Json::object();
+        if (summary.readsInput) {
+            summaryJson["reads_input"] = true;
+        }
+        if (summary.returnsInput) {
+            summaryJson["returns_input"] = true;
+        }
+        if (!summary.inputParams.empty()) {
+            summaryJson["input_params"] = summary.inputParams;
+        }
+        if (!summary.loopParams.empty()) {
+            summaryJson["loop_params"] = summary.loopParams;
+        }
+        if (!summary.calls.empty()) {
+            summaryJson["calls"] = summary.calls;
+        }
+        if (!summary.returnCalls.empty()) {
+            summaryJson["return_calls"] = summary.returnCalls;
+        }
+        if (!summary.pointerArgs.empty()) {
+            summaryJson["pointer_args"] = summary.pointerArgs;
+        }
+        if (!summary.valueArgs.empty()) {
+            summaryJson["value_args"] = summary.valueArgs;
+        }
+        return summaryJson;
+    }
+
+    // Merges a JSON summary into 'summary'. Definitions of the same symbol in several modules (inline or weak functions)
+    // are combined conservatively.
+    void mergeSummaryJson(const Json &summaryJson, FunctionFeatureSummary &summary) {
+        if (!summaryJson.is_object()) {
+            return;
+        }
+        auto flag = [&](const char *key) {
+            auto it = summaryJson.find(key);
+            return it != summaryJson.end() && it->is_boolean() && it->get<bool>();
+        };
+        summary.readsInput |= flag("reads_input");
+        summary.returnsInput |= flag("returns_input");
+        auto mergeIndices = [&](const char *key, std::set<unsigned> &target) {
+            auto it = summaryJson.find(key);
+            if (it != summaryJson.end() && it->is_array()) {
+                for (const auto &element : *it) {
+                    if (element.is_number_unsigned()) {
+                        target.insert(element.get<unsigned>());
+                    }
+                }
+            }
+        };
+        auto mergeNames = [&](const char *key, std::set<std::string> &target) {
+            auto it = summaryJson.find(key);
+            if (it != summaryJson.end() && it->is_array()) {
+                for (const auto &element : *it) {
+                    if (element.is_string()) {
+                        target.insert(element.get<std::string>());
+                    }
+                }
+            }
+        };
+        // {"callee": [[callee parameter, parameter], ...], ...}
+        auto mergeEdges = [&](const char *key, std::map<std::string, std::set<std::pair<unsigned, unsigned>>> &target) {
+            auto it = summaryJson.find(key);
+            if (it == summaryJson.end() || !it->is_object()) {
+                return;
+            }
+            for (auto callee = it->begin(); callee != it->end(); ++callee) {
+                if (!callee->is_array()) {
+                    continue;
+                }
+                for (const auto &edge : *callee) {
+                    if (edge.is_array() && edge.size() == 2 && edge[0].is_number_unsigned() && edge[1].is_number_unsigned()) {
+                        target[callee.key()].insert({edge[0].get<unsigned>(), edge[1].get<unsigned>()});
+                    }
+                }
+            }
+        };
+        mergeIndices("input_params", summary.inputParams);
+        mergeIndices("loop_params", summary.loopParams);
+        mergeNames("calls", summary.calls);
+        mergeNames("return_calls", summary.returnCalls);
+        mergeEdges("pointer_args", summary.pointerArgs);
+        mergeEdges("value_args", summary.valueArgs);
+    }
+
+}  // end of anonymous namespace
+
+Json llvm::summarizeModule(Module &M, function_ref<LoopInfo &(Function &)> getLoopInfo,
+                          const IndirectCallTargets *indirectCalls) {
+    Json moduleSummary = Json::object();
+    LocalSummaries locals(getLoopInfo, indirectCalls);
+    for (Function &F : M) {
+        if (F.isDeclaration() || F.hasLocalLinkage()) {
+            continue;
+        }
+        moduleSummary[F.getName().str()] =
+            summaryToJson(summarizeFunction(F, getLoopInfo(F), BackwardSlicer(F), nullptr, indirectCalls, &locals));
+    }
+    return moduleSummary;
+}
+
+void FeatureSummaryIndex::addModule(const Json &moduleSummary) {
+    if (!moduleSummary.is_object()) {
+        return;
+    }
+    for (auto it = moduleSummary.begin(); it != moduleSummary.end(); ++it) {
+        mergeSummaryJson(it.value(), functions[it.key()]);
+    }
+}
+
+void FeatureSummaryIndex::propagate() {
+    auto anyCallee = [&](const std::set<std::string> &callees, bool FunctionFeatureSummary::*flag) {
+        for (const std::string &callee : callees) {
+            auto it = functions.find(callee);
+            if (it != functions.end() && it->second.*flag) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Adds parameter i of the caller to its 'params' for every edge (j, i) to a callee whose 'params' has j.
+    auto passParams = [&](const std::map<std::string, std::set<std::pair<unsigned, unsigned>>> &edges,
+                          std::set<unsigned> FunctionFeatureSummary::*params, FunctionFeatureSummary &summary) {
+        bool grew = false;
+        for (const auto &calleeEdges : edges) {
+            auto it = functions.find(calleeEdges.first);
+            if (it == functions.end()) {
+                continue;
+            }
+            const std::set<unsigned> &calleeParams = it->second.*params;
+            for (const auto &edge : calleeEdges.second) {
+                if (calleeParams.count(edge.first)) {
+                    grew |= (summary.*params).insert(edge.second).second;
+                }
+            }
+        }
+        return grew;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto &entry : functions) {
+            FunctionFeatureSummary &summary = entry.second;
+            if (!summary.readsInput && anyCallee(summary.calls, &FunctionFeatureSummary::readsInput)) {
+                summary.readsInput = true;
+                changed = true;
+            }
+            if (!summary.returnsInput && anyCallee(summary.returnCalls, &FunctionFeatureSummary::returnsInput)) {
+                summary.returnsInput = true;
+                changed = true;
+            }
+            changed |= passParams(summary.pointerArgs, &FunctionFeatureSummary::inputParams, summary);
+            changed |= passParams(summary.valueArgs, &FunctionFeatureSummary::loopParams, summary);
+        }
+    }
+}
+
+const FunctionFeatureSummary *FeatureSummaryIndex::lookup(StringRef name) const {
+    auto it = functions.find(name.str());
+    return it == functions.end() ? nullptr : &it->second;
+}
+
+bool FeatureSummaryIndex::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        errs() << "Cannot open summary index " << path << "\n";
+        return false;
+    }
+    Json indexJson = Json::parse(file, nullptr, /*allow_exceptions=*/false);
+    if (indexJson.is_discarded() || !indexJson.is_object() || !indexJson.contains("functions")) {
+        errs() << "Malformed summary index " << path << "\n";
+        return false;
+    }
+    addModule(indexJson["functions"]);
+    return true;
+}
+
+Json FeatureSummaryIndex::toJson() const {
+    Json functionsJson = Json::object();
+    for (const auto &entry : functions) {
+        functionsJson[entry.first] = summaryToJson(entry.second);
+    }
+    Json indexJson;
+    indexJson["functions"] = functionsJson;
+    return indexJson;
+}
+
+struct CallStringSummaries::FunctionInfo {
+    explicit FunctionInfo(Function &F) : DT(F), LI(DT), slicer(F) {}
+
+    DominatorTree DT;
+    LoopInfo LI;
+    BackwardSlicer slicer;
+};
+
+CallStringSummaries::CallStringSummaries(unsigned depth, unsigned maxContexts, const FeatureSummaryIndex *imported,
+                                         const IndirectCallTargets *indirectCalls)
+    : depth(depth), maxContexts(maxContexts), imported(imported), indirectCalls(indirectCalls) {}
+
+CallStringSummaries::CallStringSummaries(CallStringSummaries &&) = default;
+
+CallStringSummaries::~CallStringSummaries() = default;
+
+bool CallStringSummaries::invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv) {
+    auto PAC = PA.getChecker<CallStringAnalysis>();
+    return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Module>>()) || Inv.invalidate<IndirectCallAnalysis>(M, PA);
+}
+
+const FunctionFeatureSummary *CallStringSummaries::lookup(const CallBase *CI) {
+    return calleeSummary(CI, {});
+}
+
+CallStringSummaries::CallString CallStringSummaries::extend(const CallBase *CI, const CallString &context) const {
+    CallString extended;
+    if (depth > 0) {
+        extended.push_back(CI);
+        extended.insert(extended.end(), context.begin(), context.begin() + std::min<size_t>(context.size(), depth - 1));
+    }
+    return extended;
+}
+
+// The summary of the callee of CI, made by a function running under 'context'.
+const FunctionFeatureSummary *CallStringSummaries::calleeSummary(const CallBase *CI, const CallString &context) {
+    const Function *callee = CI->getCalledFunction();
+    if (!callee) {
+        const IndirectCallInfo *dispatch = indirectCalls ? indirectCalls->lookup(CI) : nullptr;
+        return dispatch && !dispatch->targets.empty() ? &dispatchSummary(CI, context) : nullptr;
+    }
+    if (isInputFunction(callee)) {
+        return nullptr;
+    }
+    if (callee->isDeclaration()) {
+        return imported ? imported->lookup(callee->getName()) : nullptr;
+    }
+    return &summary(callee, extend(CI, context));
+}
+
+// The union of the summaries of the targets of the indirect call CI, made under 'context'. Like summary, the entry
+// exists before the targets are summarized, so a target calling back through CI sees it as it stands.
+const FunctionFeatureSummary &CallStringSummaries::dispatchSummary(const CallBase *CI, const CallString &context) {
+    CallString calleeContext = extend(CI, context);
+    auto inserted = dispatches.try_emplace({CI, calleeContext});
+    if (!inserted.second) {
+        return inserted.first->second;
+    }
+    FunctionFeatureSummary merged;
+    for (const Function *target : indirectCalls->lookup(CI)->targets) {
+        const FunctionFeatureSummary *targetSummary = nullptr;
+        if (isInputFunction(target)) {
+            merged.readsInput = true;
+            merged.returnsInput = true;
+        } else if (target->isDeclaration()) {
+            targetSummary = imported ? imported->lookup(target->getName()) : nullptr;
+        } else {
+            targetSummary = &summary(target, calleeContext);
+        }
+        if (!targetSummary) {
+            continue;
+        }
+        merged.readsInput |= targetSummary->readsInput;
+        merged.returnsInput |= targetSummary->returnsInput;
+        merged.inputParams.insert(targetSummary->inputParams.begin(), targetSummary->inputParams.end());
+        merged.loopParams.insert(targetSummary->loopParams.begin(), targetSummary->loopParams.end());
+        merged.calls.insert(targetSummary->calls.begin(), targetSummary->calls.end());
+        merged.returnCalls.insert(targetSummary->returnCalls.begin(), targetSummary->returnCalls.end());
+    }
+    inserted.first->second = std::move(merged);
+    return inserted.first->second;
+}
+
+/**
+ * Function: CallStringSummaries::summary
+ *
+ * Description:
+ * The summary of F under the call string 'context', computed on first use by summarizeFunction with the parameters
+ * that carry input in this context and with each call F makes resolved under the call string it extends. The entry
+ * is created before F is summarized, so a recursive call sees the summary as it stands (empty) instead of looping.
+ * Once maxContexts summaries exist, new call strings are dropped and F gets its context-insensitive summary.
+ */
+
+const FunctionFeatureSummary &CallStringSummaries::summary(const Function *F, CallString context) {
+    if (summaries.size() >= maxContexts && maxContexts > 0) {
+        context.clear();
+    }
+    auto inserted = summaries.try_emplace({F, context});
+    if (!inserted.second) {
+        return inserted.first->second;
+    }
+    const std::set<unsigned> &inputParams = argumentsFromInput(context);
+    auto resolve = [&](const CallBase *CI) { return calleeSummary(CI, context); };
+    SummaryContext summaryContext{resolve, inputParams};
+    FunctionInfo &info = functionInfo(F);
+    inserted.first->second = summarizeFunction(const_cast<Function &>(*F), info.LI, info.slicer, &summaryContext);
+    return inserted.first->second;
+}
+
+// The parameters carrying input in the callee of the first call of 'context': those whose argument is sliced back to
+// input in the caller, under the rest of the string.
+const std::set<unsigned> &CallStringSummaries::argumentsFromInput(const CallString &context) {
+    auto inserted = inputArguments.try_emplace(context);
+    if (!inserted.second || context.empty()) {
+        return inserted.first->second;
+    }
+    const CallBase *CI = context.front();
+    CallString callerContext(context.begin() + 1, context.end());
+    const std::set<unsigned> &callerParams = argumentsFromInput(callerContext);
+    auto resolve = [&](const CallBase *call) { return calleeSummary(call, callerContext); };
+    SummaryContext summaryContext{resolve, callerParams};
+    const BackwardSlicer &slicer = functionInfo(CI->getFunction()).slicer;
+    std::set<unsigned> params;
+    for (unsigned argNo = 0; argNo < CI->arg_size(); ++argNo) {
+        bool fromInput = false;
+        slicer.slice(CI->getArgOperand(argNo), [&](Value *V) {
+            if (auto *call = dyn_cast<CallBase>(V)) {
+                fromInput |= callReadsInput(call, &summaryContext);
+            } else {
+                fromInput |= isInputParam(V, &summaryContext);
+            }
+        });
+        if (fromInput) {
+            params.insert(argNo);
+        }
+    }
+    inserted.first->second = std::move(params);
+    return inserted.first->second;
+}
+
+CallStringSummaries::FunctionInfo &CallStringSummaries::functionInfo(const Function *F) {
+    std::unique_ptr<FunctionInfo> &info = functions[F];
+    if (!info) {
+        info = std::make_unique<FunctionInfo>(const_cast<Function &>(*F));
+    }
+    return *info;
+}
+
+namespace {
+
+    // The global 'pointer' points into, unless it is constant.
+    GlobalVariable *writableGlobal(Value *pointer) {
+        auto *GV = dyn_cast<GlobalVariable>(getUnderlyingObject(pointer));
+        return GV && !GV->isConstant() ? GV : nullptr;
+    }
+
+}  // end of anonymous namespace
+
+/**
+ * Function: GlobalInputSummary::GlobalInputSummary
+ *
+ * Description:
+ * Scans every function of M once. Input calls and calls whose context-insensitive summary fills a pointer parameter
+ * with input write the globals their arguments point into; a store into a global is sliced back to the input calls
+ * and the globals its value comes from. The calls then flow along the global-to-global edges until nothing changes,
+ * so a global computed from an input global in yet another function is input as well. Loads give the readers.
+ */
+
+GlobalInputSummary::GlobalInputSummary(Module &M, const IndirectCallTargets *indirectCalls) {
+    CallStringSummaries callSummaries(0, 0, nullptr, indirectCalls);
+    auto resolve = [&](const CallBase *CI) { return callSummaries.lookup(CI); };
+    std::set<unsigned> noInputParams;
+    SummaryContext context{resolve, noInputParams};
+
+    DenseMap<const GlobalVariable *, SetVector<const CallBase *>> written;
+    DenseMap<const GlobalVariable *, SetVector<const GlobalVariable *>> flowsInto;
+    DenseMap<const GlobalVariable *, SetVector<const Function *>> loadedBy;
+    for (Function &F : M) {
+        if (F.isDeclaration()) {
+            continue;
+        }
+        BackwardSlicer slicer(F);
+        for (Instruction &I : instructions(F)) {
+            if (auto *Load = dyn_cast<LoadInst>(&I)) {
+                if (GlobalVariable *GV = writableGlobal(Load->getPointerOperand())) {
+                    loadedBy[GV].insert(&F);
+                }
+            } else if (auto *CI = dyn_cast<CallBase>(&I)) {
+                if (isInputFunction(CI->getCalledFunction())) {
+                    for (Value *arg : CI->args()) {
+                        if (GlobalVariable *GV = writableGlobal(arg)) {
+                            written[GV].insert(CI);
+                        }
+                    }
+                } else if (const FunctionFeatureSummary *summary = callSummaries.lookup(CI)) {
+                    for (unsigned argNo : summary->inputParams) {
+                        GlobalVariable *GV = argNo < CI->arg_size() ? writableGlobal(CI->getArgOperand(argNo)) : nullptr;
+                        if (GV) {
+                            written[GV].insert(CI);
+                        }
+                    }
+                }
+            } else if (auto *SI = dyn_cast<StoreInst>(&I)) {
+                GlobalVariable *GV = writableGlobal(SI->getPointerOperand());
+                if (!GV) {
+                    continue;
+                }
+                slicer.slice(SI->getValueOperand(), [&](Value *V) {
+                    if (auto *call = dyn_cast<CallBase>(V)) {
+                        if (callReadsInput(call, &context)) {
+                            written[GV].insert(call);
+                        }
+                    } else if (auto *source = dyn_cast<GlobalVariable>(V)) {
+                        if (source != GV && !source->isConstant()) {
+                            flowsInto[source].insert(GV);
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    SmallVector<const GlobalVariable *, 16> worklist;
+    for (const auto &entry : written) {
+        worklist.push_back(entry.first);
+    }
+    while (!worklist.empty()) {
+        const GlobalVariable *source = worklist.pop_back_val();
+        auto edges = flowsInto.find(source);
+        if (edges == flowsInto.end()) {
+            continue;
+        }
+        // Copied first: adding the target to 'written' may move the source's entry.
+        SmallVector<const CallBase *, 8> calls(written[source].begin(), written[source].end());
+        for (const GlobalVariable *target : edges->second) {
+            SetVector<const CallBase *> &targetCalls = written[target];
+            bool grew = false;
+            for (const CallBase *CI : calls) {
+                grew |= targetCalls.insert(CI);
+            }
+            if (grew) {
+                worklist.push_back(target);
+            }
+        }
+    }
+
+    for (auto &entry : written) {
+        if (entry.second.empty()) {
+            continue;
+        }
+        GlobalInputInfo &info = globals[entry.first];
+        info.sources.assign(entry.second.begin(), entry.second.end());
+        auto loads = loadedBy.find(entry.first);
+        if (loads != loadedBy.end()) {
+            info.readers.assign(loads->second.begin(), loads->second.end());
+            readers.insert(loads->second.begin(), loads->second.end());
+        }
+    }
+}
+
+bool GlobalInputSummary::invalidate(Module &M, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &Inv) {
+    auto PAC = PA.getChecker<GlobalInputAnalysis>();
+    return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Module>>()) || Inv.invalidate<IndirectCallAnalysis>(M, PA);
+}
+
+GlobalInputSummary GlobalInputAnalysis::run(Module &M, ModuleAnalysisManager &MAM) {
+    return GlobalInputSummary(M, &MAM.getResult<IndirectCallAnalysis>(M));
+}
+
+AnalysisKey GlobalInputAnalysis::Key;
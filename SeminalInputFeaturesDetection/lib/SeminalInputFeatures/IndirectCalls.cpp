@@ -0,0 +1,265 @@
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include <map>
+#include <memory>
+using namespace llvm;
+
+static cl::opt<bool> RefineIndirectCalls(
+    "seminal-refine-indirect-calls", cl::init(true),
+    cl::desc("Narrow the targets of an indirect call to the functions its pointer is followed back to in its function"));
+
+namespace {
+
+    // Pointers are interchangeable as arguments and results, as they are for a C call through a cast pointer.
+    bool fits(Type *expected, Type *actual) {
+        return expected == actual || (expected->isPointerTy() && actual->isPointerTy());
+    }
+
+    // Whether F can be called with the arguments and result of CB.
+    bool fitsCall(const Function &F, const CallBase &CB) {
+        FunctionType *type = F.getFunctionType();
+        if (!fits(type->getReturnType(), CB.getType())) {
+            return false;
+        }
+        unsigned params = type->getNumParams();
+        if (type->isVarArg() ? CB.arg_size() < params : CB.arg_size() != params) {
+            return false;
+        }
+        for (unsigned i = 0; i < params; ++i) {
+            if (!fits(type->getParamType(i), CB.getArgOperand(i)->getType())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Adds the functions a constant initializer holds, looking into arrays, structs and casts.
+    void collectFunctions(const Constant *C, SetVector<const Function *> &targets) {
+        if (const auto *F = dyn_cast<Function>(C->stripPointerCasts())) {
+            targets.insert(F);
+            return;
+        }
+        if (isa<ConstantAggregate>(C)) {
+            for (const Use &operand : C->operands()) {
+                collectFunctions(cast<Constant>(operand.get()), targets);
+            }
+        }
+    }
+
+    // An alloca whose address is only loaded from and stored to, so its stores are all that it can hold.
+    bool isPrivateSlot(const AllocaInst *AI) {
+        for (const User *U : AI->users()) {
+            if (const auto *Store = dyn_cast<StoreInst>(U)) {
+                if (Store->getValueOperand() == AI) {
+                    return false;
+                }
+            } else if (!isa<LoadInst>(U) && !isa<DbgInfoIntrinsic>(U) && !U->isDroppable() &&
+                       !(isa<IntrinsicInst>(U) && cast<IntrinsicInst>(U)->isLifetimeStartOrEnd())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Class: PointerWalk
+     *
+     * Description:
+     * Follows function pointers back within one function to the functions they may hold (see IndirectCallTargets).
+     * The conditions choosing among them are the conditions of selects and of the branches that a store into a slot,
+     * or the predecessor of a phi edge, is control dependent on, found with the post-dominator tree, which is built
+     * on the first query. Those branches are followed to the branches they depend on in turn.
+     */
+
+    class PointerWalk {
+    public:
+        explicit PointerWalk(Function &F) : F(F) {}
+
+        // Adds what 'pointer' may hold to 'targets'; false if it reaches a pointer that is not followed.
+        bool resolve(const Value *pointer, SetVector<const Function *> &targets, SetVector<const Value *> &conditions) {
+            SmallPtrSet<const Value *, 16> visited;
+            return resolve(pointer, visited, targets, conditions);
+        }
+
+    private:
+        Function &F;
+        std::unique_ptr<PostDominatorTree> PDT;
+
+        bool resolve(const Value *V, SmallPtrSetImpl<const Value *> &visited, SetVector<const Function *> &targets,
+                     SetVector<const Value *> &conditions) {
+            V = V->stripPointerCasts();
+            if (!visited.insert(V).second) {
+                return true;
+            }
+            if (const auto *Fn = dyn_cast<Function>(V)) {
+                targets.insert(Fn);
+                return true;
+            }
+            // Nothing is called through a null pointer, so it adds no target.
+            if (isa<ConstantPointerNull>(V) || isa<UndefValue>(V)) {
+                return true;
+            }
+            if (const auto *Select = dyn_cast<SelectInst>(V)) {
+                conditions.insert(Select->getCondition());
+                return resolve(Select->getTrueValue(), visited, targets, conditions) &&
+                       resolve(Select->getFalseValue(), visited, targets, conditions);
+            }
+            if (const auto *Phi = dyn_cast<PHINode>(V)) {
+                for (unsigned i = 0; i < Phi->getNumIncomingValues(); ++i) {
+                    const BasicBlock *incoming = Phi->getIncomingBlock(i);
+                    addCondition(incoming->getTerminator(), conditions);
+                    controlConditions(incoming, conditions);
+                    if (!resolve(Phi->getIncomingValue(i), visited, targets, conditions)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            const auto *Load = dyn_cast<LoadInst>(V);
+            if (!Load) {
+                return false;
+            }
+            const Value *object = getUnderlyingObject(Load->getPointerOperand());
+            if (const auto *GV = dyn_cast<GlobalVariable>(object)) {
+                if (!GV->isConstant() || !GV->hasDefinitiveInitializer()) {
+                    return false;
+                }
+                // A table of functions: which entry is loaded is read by the walk over the called pointer.
+                size_t found = targets.size();
+                collectFunctions(GV->getInitializer(), targets);
+                return targets.size() > found;
+            }
+            const auto *AI = dyn_cast<AllocaInst>(object);
+            if (!AI || object != Load->getPointerOperand()->stripPointerCasts() || !isPrivateSlot(AI)) {
+                return false;
+            }
+            for (const User *U : AI->users()) {
+                if (const auto *Store = dyn_cast<StoreInst>(U)) {
+                    controlConditions(Store->getParent(), conditions);
+                    if (!resolve(Store->getValueOperand(), visited, targets, conditions)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void addCondition(const Instruction *terminator, SetVector<const Value *> &conditions) {
+            if (const auto *BI = dyn_cast<BranchInst>(terminator)) {
+                if (BI->isConditional()) {
+                    conditions.insert(BI->getCondition());
+                }
+            } else if (const auto *SI = dyn_cast<SwitchInst>(terminator)) {
+                conditions.insert(SI->getCondition());
+            }
+        }
+
+        // Adds the conditions of the branches BB is control dependent on, transitively.
+        void controlConditions(const BasicBlock *BB, SetVector<const Value *> &conditions) {
+            if (!PDT) {
+                PDT = std::make_unique<PostDominatorTree>(F);
+            }
+            SmallPtrSet<const BasicBlock *, 8> seen{BB};
+            SmallVector<const BasicBlock *, 8> worklist{BB};
+            while (!worklist.empty()) {
+                const BasicBlock *dependent = worklist.pop_back_val();
+                for (const BasicBlock &branching : F) {
+                    const Instruction *terminator = branching.getTerminator();
+                    if (!terminator || terminator->getNumSuccessors() < 2 ||
+                        PDT->properlyDominates(dependent, &branching)) {
+                        continue;
+                    }
+                    bool decides = llvm::any_of(successors(&branching), [&](const BasicBlock *successor) {
+                        return PDT->dominates(dependent, successor);
+                    });
+                    if (decides) {
+                        addCondition(terminator, conditions);
+                        if (seen.insert(&branching).second) {
+                            worklist.push_back(&branching);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+}  // end of anonymous namespace
+
+/**
+ * Function: IndirectCallTargets::IndirectCallTargets
+ *
+ * Description:
+ * Lists the address-taken functions of M, then resolves every call of M whose callee is not a function: by
+ * PointerWalk when refinement is on and reaches only functions, otherwise by signature, the functions fitting a
+ * signature being computed for its first call only.
+ */
+
+IndirectCallTargets::IndirectCallTargets(Module &M) {
+    std::vector<const Function *> addressTaken;
+    for (const Function &F : M) {
+        if (!F.isIntrinsic() && F.hasAddressTaken()) {
+            addressTaken.push_back(&F);
+        }
+    }
+    std::map<std::pair<FunctionType *, unsigned>, std::vector<const Function *>> bySignature;
+
+    for (Function &F : M) {
+        std::unique_ptr<PointerWalk> walk;
+        for (Instruction &I : instructions(F)) {
+            auto *CB = dyn_cast<CallBase>(&I);
+            if (!CB || CB->getCalledFunction() || CB->isInlineAsm()) {
+                continue;
+            }
+            IndirectCallInfo &info = calls[CB];
+            if (const auto *callee = dyn_cast<Function>(CB->getCalledOperand()->stripPointerCasts())) {
+                info.targets.push_back(callee);
+                info.refined = true;
+                continue;
+            }
+            if (RefineIndirectCalls) {
+                if (!walk) {
+                    walk = std::make_unique<PointerWalk>(F);
+                }
+                SetVector<const Function *> targets;
+                SetVector<const Value *> conditions;
+                if (walk->resolve(CB->getCalledOperand(), targets, conditions) && !targets.empty()) {
+                    // Module order, like the unrefined targets.
+                    for (const Function *candidate : addressTaken) {
+                        if (targets.count(candidate)) {
+                            info.targets.push_back(candidate);
+                        }
+                    }
+                    info.conditions.assign(conditions.begin(), conditions.end());
+                    info.refined = true;
+                    continue;
+                }
+            }
+            auto signature = bySignature.try_emplace({CB->getFunctionType(), CB->arg_size()});
+            if (signature.second) {
+                for (const Function *candidate : addressTaken) {
+                    if (fitsCall(*candidate, *CB)) {
+                        signature.first->second.push_back(candidate);
+                    }
+                }
+            }
+            info.targets = signature.first->second;
+        }
+    }
+}
+
+bool IndirectCallTargets::invalidate(Module &, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &) {
+    auto PAC = PA.getChecker<IndirectCallAnalysis>();
+    return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Module>>());
+}
+
+AnalysisKey IndirectCallAnalysis::Key;
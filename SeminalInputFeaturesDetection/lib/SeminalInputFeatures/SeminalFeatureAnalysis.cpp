@@ -0,0 +1,2704 @@
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Demangle/Demangle.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/ProfileSummary.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/ProfileData/InstrProfReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Transforms/Instrumentation/PGOInstrumentation.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/FunctionComparator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <tuple>
+#include <vector>
+#include <set>
+#include <queue>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+using namespace llvm;
+using Json = nlohmann::json;
+
+static cl::opt<bool> DeduplicateFunctions(
+    "seminal-dedup-functions", cl::init(true),
+    cl::desc("Analyze structurally identical functions once and remap the result to each copy"));
+
+static cl::opt<bool> UseAliasAnalysis(
+    "seminal-use-aa", cl::init(true),
+    cl::desc("Follow loads into the stores and calls alias analysis says may modify them, and prune pointer arguments calls do not read"));
+
+static cl::opt<unsigned> FunctionTopK(
+    "seminal-top-k", cl::init(10),
+    cl::desc("Maximum number of features reported per function, hottest first (0 reports all)"));
+
+static cl::opt<unsigned> ModuleTopK(
+    "seminal-module-top-k", cl::init(200),
+    cl::desc("Maximum number of features reported per module, hottest first (0 reports all)"));
+
+static cl::opt<cl::boolOrDefault> OptimizedIR(
+    "seminal-optimized-ir",
+    cl::desc("Name variables through dbg.value, debug records and SSA names, for -O1/-O2 IR "
+             "(default: for functions without dbg.declare)"));
+
+static cl::opt<unsigned> FunctionStepBudget(
+    "seminal-function-step-budget", cl::init(20000000),
+    cl::desc("Maximum def-use walk steps (values visited and alias queries) per function before it falls back to "
+             "a cheaper over-approximation (0: no limit)"));
+
+static cl::opt<unsigned> FunctionMemoryBudget(
+    "seminal-function-memory-budget", cl::init(1024),
+    cl::desc("Maximum estimated memory in MiB of a function's def-use walks before it falls back to a cheaper "
+             "over-approximation (0: no limit)"));
+
+static cl::opt<unsigned> FunctionTimeBudget(
+    "seminal-function-time-budget", cl::init(0),
+    cl::desc("Maximum wall time in milliseconds of a function's def-use walks before it falls back to a cheaper "
+             "over-approximation (0: no limit)"));
+
+static cl::opt<unsigned> ModuleStepBudget(
+    "seminal-module-step-budget", cl::init(0),
+    cl::desc("Maximum def-use walk steps per module; once spent, the remaining functions get the cheaper "
+             "over-approximation (0: no limit)"));
+
+static cl::opt<unsigned> ModuleMemoryBudget(
+    "seminal-module-memory-budget", cl::init(0),
+    cl::desc("Maximum estimated memory in MiB of the module's retained results plus the current function's walks "
+             "(0: no limit)"));
+
+static cl::opt<bool> MemoryReport(
+    "seminal-memory-report",
+    cl::desc("Account the bytes held by the visited sets, variable maps, results and JSON of the analysis, and report "
+             "per-function peaks and the module high-water mark next to the results"));
+
+static cl::opt<unsigned> ModuleTimeBudget(
+    "seminal-module-time-budget", cl::init(0),
+    cl::desc("Maximum wall time in milliseconds of the analysis of a module (0: no limit)"));
+
+static cl::opt<unsigned> FunctionThreads(
+    "seminal-function-threads", cl::init(1),
+    cl::desc("Threads sharing the condition and value flow walks of one large function "
+             "(0: one per hardware thread, 1: analyze every function on the calling thread; "
+             "default: 1, or the pool seminal-batch shares among its workers)"));
+
+static cl::opt<unsigned> ParallelWalkThreshold(
+    "seminal-parallel-walks", cl::init(64),
+    cl::desc("Minimum number of condition or value flow walks in a function for them to be spread over threads"));
+
+static cl::opt<bool> InputAttribution(
+    "seminal-input-attribution", cl::init(true),
+    cl::desc("Attribute every feature and control point to the input call sites whose data reaches it"));
+
+static cl::opt<unsigned> ContextDepth(
+    "seminal-context-depth", cl::init(2),
+    cl::desc("Length of the call strings distinguishing the calls of a function defined in the module (0: one summary per function)"));
+
+static cl::opt<unsigned> ContextLimit(
+    "seminal-context-limit", cl::init(1000),
+    cl::desc("Maximum number of call string summaries per module, after which calls get context-insensitive summaries (0: no limit)"));
+
+static cl::opt<bool> CxxInput(
+    "seminal-cxx-input", cl::init(true),
+    cl::desc("Recognize the input streams of libstdc++ and libc++ (std::cin >>, std::getline, std::ifstream) by their demangled names"));
+
+static cl::opt<std::string> ProfileFile(
+    "seminal-profile",
+    cl::desc("IR instrumentation profile (.profdata) applied to a copy of each module, to score features by the "
+             "executions of the loops and branches they control"),
+    cl::value_desc("filename"));
+
+static cl::opt<bool> SuppressCold(
+    "seminal-suppress-cold", cl::init(true),
+    cl::desc("With profile counts, leave out the features whose loops and branches are all cold"));
+
+static cl::opt<double> ColdRatio(
+    "seminal-cold-ratio", cl::init(0.001),
+    cl::desc("With profile counts, blocks executed less often than this fraction of the profile's largest count are cold"));
+
+struct VariableInfo {
+    std::string name;
+    int line;
+    const DbgDeclareInst *declaration; // where name and line come from; used to remap results between identical functions
+    const Value *value;                // in optimized IR, the SSA value the name describes instead
+
+    VariableInfo() : name(""), line(-1), declaration(nullptr), value(nullptr) {} // Default constructor
+    VariableInfo(std::string n, int l, const DbgDeclareInst *d = nullptr, const Value *v = nullptr) : name(n), line(l), declaration(d), value(v) {} // Parameterized constructor
+};
+
+namespace {
+
+    enum MemoryCategory { VisitedSets, VariableMaps, NumMemoryCategories };
+
+    // Bytes held by the walk containers of the function being analyzed on this thread, with -seminal-memory-report.
+    struct MemoryAccount {
+        uint64_t current[NumMemoryCategories] = {};
+        uint64_t peak[NumMemoryCategories] = {};
+        uint64_t currentTotal = 0;
+        uint64_t peakTotal = 0;
+
+        void allocate(MemoryCategory category, uint64_t bytes) {
+            current[category] += bytes;
+            peak[category] = std::max(peak[category], current[category]);
+            currentTotal += bytes;
+            peakTotal = std::max(peakTotal, currentTotal);
+        }
+
+        void deallocate(MemoryCategory category, uint64_t bytes) {
+            // Containers created before the account was installed may be freed while it is.
+            current[category] -= std::min(current[category], bytes);
+            currentTotal -= std::min(currentTotal, bytes);
+        }
+
+        // Accounts for walks that ran concurrently on other threads, each charging one of 'others', on top of what
+        // this account holds now.
+        void addConcurrentPeaks(const std::vector<MemoryAccount> &others) {
+            uint64_t concurrent[NumMemoryCategories] = {};
+            uint64_t concurrentTotal = 0;
+            for (const MemoryAccount &other : others) {
+                for (unsigned category = 0; category < NumMemoryCategories; ++category) {
+                    concurrent[category] += other.peak[category];
+                }
+                concurrentTotal += other.peakTotal;
+            }
+            for (unsigned category = 0; category < NumMemoryCategories; ++category) {
+                peak[category] = std::max(peak[category], current[category] + concurrent[category]);
+            }
+            peakTotal = std::max(peakTotal, currentTotal + concurrentTotal);
+        }
+    };
+
+    thread_local MemoryAccount *currentMemoryAccount = nullptr;
+
+    // std::allocator that also charges the thread's MemoryAccount, if one is installed. It is stateless, so the
+    // containers using it are constructed and passed around like their plain std counterparts.
+    template <typename T, MemoryCategory Category>
+    struct AccountedAllocator {
+        using value_type = T;
+        template <typename U> struct rebind { using other = AccountedAllocator<U, Category>; };
+
+        AccountedAllocator() = default;
+        template <typename U> AccountedAllocator(const AccountedAllocator<U, Category> &) {}
+
+        T *allocate(size_t n) {
+            if (MemoryAccount *account = currentMemoryAccount) {
+                account->allocate(Category, n * sizeof(T));
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, size_t n) {
+            if (MemoryAccount *account = currentMemoryAccount) {
+                account->deallocate(Category, n * sizeof(T));
+            }
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U> bool operator==(const AccountedAllocator<U, Category> &) const { return true; }
+        template <typename U> bool operator!=(const AccountedAllocator<U, Category> &) const { return false; }
+    };
+
+}  // end of anonymous namespace
+
+using VisitedSet = std::set<Value *, std::less<Value *>, AccountedAllocator<Value *, VisitedSets>>;
+
+// Variable name -> where the variable is declared.
+using VariableMap = std::unordered_map<std::string, VariableInfo, std::hash<std::string>, std::equal_to<std::string>,
+                                       AccountedAllocator<std::pair<const std::string, VariableInfo>, VariableMaps>>;
+
+// Variables written by input, with the input calls that write them.
+using IOVariableMap = std::unordered_map<std::string, std::vector<const CallBase *>, std::hash<std::string>, std::equal_to<std::string>,
+                                         AccountedAllocator<std::pair<const std::string, std::vector<const CallBase *>>, VariableMaps>>;
+
+namespace {
+
+    // How a library function takes part in the analysis, see classifyFunction.
+    struct LibraryFunction {
+        bool input = false;              // reads input, see isInputFunction
+        bool returnsInput = false;       // its result is input: fopen, getc, or the stream an extraction returns
+        bool opensStream = false;        // fopen, or the constructor or open of a file stream, whose stream is the input
+        unsigned firstArgument = ~0u;    // the arguments from this one up to endArgument are written with input
+        unsigned endArgument = ~0u;
+        bool containerSize = false;      // size, length or empty of a std::string or std::vector
+    };
+
+    // Input functions of the C library, matched by name.
+    LibraryFunction classifyCFunction(StringRef name) {
+        LibraryFunction kind;
+        if (name.contains("scanf")) {
+            // Input is written after the format of scanf, after the stream or string of fscanf and sscanf.
+            kind.input = kind.returnsInput = true;
+            kind.firstArgument = name.contains("fscanf") || name.contains("sscanf") ? 2 : 1;
+        } else if (name.contains("fopen")) {
+            kind.input = kind.returnsInput = kind.opensStream = true;
+        } else if (name.contains("getc")) {
+            kind.input = kind.returnsInput = true;
+        }
+        return kind;
+    }
+
+    // A demangled class or namespace name without its template arguments and the inline namespaces of libstdc++
+    // (__cxx11) and libc++ (__1), so that both spell std::basic_istream the same way.
+    std::string plainName(StringRef name) {
+        name = name.take_while([](char c) { return isAlnum(c) || c == '_' || c == ':'; });
+        std::string plain;
+        while (!name.empty()) {
+            StringRef part;
+            std::tie(part, name) = name.split("::");
+            if (part != "__1" && part != "__cxx11") {
+                plain += plain.empty() ? part.str() : "::" + part.str();
+            }
+        }
+        return plain;
+    }
+
+    // Part of the name 'demangler' holds, such as its base name or declaration context.
+    std::string demangledPart(const ItaniumPartialDemangler &demangler,
+                              char *(ItaniumPartialDemangler::*part)(char *, size_t *) const) {
+        size_t size = 0;
+        char *buffer = (demangler.*part)(nullptr, &size);
+        if (!buffer) {
+            return "";
+        }
+        std::string result(buffer);
+        std::free(buffer);
+        return result;
+    }
+
+    /**
+     * Function: classifyCxxFunction
+     *
+     * Description:
+     * Recognizes the input functions of libstdc++ and libc++ by their demangled names: the extractions of an input
+     * stream (operator>>, getline, read, readsome and get, members or free functions taking the stream first), which
+     * write their input through the argument after the stream and return the stream, whose state is input too; and the
+     * constructors and open of the file streams, which make the stream object the input, as fopen does its result. Also
+     * marks size, length and empty of std::string and std::vector, through which the containers filled by input are read.
+     */
+
+    LibraryFunction classifyCxxFunction(const std::string &name) {
+        static const StringSet<> inputStreams = {"std::basic_istream", "std::basic_iostream", "std::basic_ifstream",
+                                                 "std::basic_fstream", "std::istream", "std::iostream"};
+        static const StringSet<> fileStreams = {"std::basic_ifstream", "std::basic_fstream"};
+        static const StringSet<> containers = {"std::basic_string", "std::string", "std::vector"};
+        static const StringSet<> extractions = {"operator>>", "getline", "read", "readsome", "get"};
+
+        LibraryFunction kind;
+        ItaniumPartialDemangler demangler;
+        // The demangler refers into 'name' until it is done.
+        if (demangler.partialDemangle(name.c_str()) || !demangler.isFunction()) {
+            return kind;
+        }
+        std::string base = demangledPart(demangler, &ItaniumPartialDemangler::getFunctionBaseName);
+        std::string context = plainName(demangledPart(demangler, &ItaniumPartialDemangler::getFunctionDeclContextName));
+        bool extraction = false;
+        if (inputStreams.count(context)) {
+            extraction = extractions.count(base);
+        } else if (context == "std" && (base == "operator>>" || base == "getline")) {
+            std::string parameters = demangledPart(demangler, &ItaniumPartialDemangler::getFunctionParameters);
+            extraction = inputStreams.count(plainName(StringRef(parameters).drop_front()));
+        }
+        if (extraction) {
+            kind.input = kind.returnsInput = true;
+            kind.firstArgument = 1;
+            kind.endArgument = 2;
+        } else if (fileStreams.count(context) &&
+                   (base == "open" || (demangler.isCtorOrDtor() && !StringRef(base).startswith("~")))) {
+            kind.input = kind.opensStream = true;
+            kind.firstArgument = 0;
+            kind.endArgument = 1;
+        } else if (containers.count(context)) {
+            kind.containerSize = base == "size" || base == "length" || base == "empty";
+        }
+        return kind;
+    }
+
+    // Classifications of the functions this thread has seen. Each is checked against the name of its function, since
+    // a function freed with its module may leave its address to a function of the next one.
+    struct ClassifiedFunction {
+        std::string name;
+        LibraryFunction kind;
+    };
+
+    thread_local DenseMap<const Function *, ClassifiedFunction> classifiedFunctions;
+    constexpr size_t MaxClassifiedFunctions = 1 << 16;
+
+    // What F is to the analysis. C functions are matched by name; with -seminal-cxx-input, a mangled name that is not
+    // is demangled once, the first time the thread sees F, so recognizing C++ input costs a lookup per call after that.
+    LibraryFunction classifyFunction(const Function *F) {
+        if (!F) {
+            return LibraryFunction();
+        }
+        auto found = classifiedFunctions.find(F);
+        if (found != classifiedFunctions.end() && found->second.name == F->getName()) {
+            return found->second.kind;
+        }
+        if (classifiedFunctions.size() >= MaxClassifiedFunctions) {
+            classifiedFunctions.clear();
+        }
+        ClassifiedFunction &entry = classifiedFunctions[F];
+        entry.name = F->getName().str();
+        entry.kind = classifyCFunction(entry.name);
+        if (!entry.kind.input && CxxInput && StringRef(entry.name).startswith("_Z")) {
+            entry.kind = classifyCxxFunction(entry.name);
+        }
+        return entry.kind;
+    }
+
+}  // end of anonymous namespace
+
+/**
+ * Function: isInputFunction
+ * 
+ * Description:
+ * This function checks if a given LLVM Function is an input-related function, specifically looking for functions like 'scanf', 'fopen', and 'getc',
+ * and, in C++, for the extractions of std::cin and other input streams (operator>>, std::getline, read, get) and the constructor and open of std::ifstream.
+ * It is used to identify functions that are related to input operations in a program, which is crucial for analyzing the flow of data from input sources to key points in the program.
+ * 
+ * Inputs:
+ * - const Function* F: A pointer to an LLVM Function object. This function is being checked to determine if it is an input-related function.
+ * 
+ * Output:
+ * - Returns true if the function is identified as an input function.
+ * - Returns false if the function is not an input function or if the input Function pointer is null.
+ * 
+ * Implementation Details:
+ * - The function name is checked for the presence of substrings "scanf", "fopen", or "getc".
+ * - Other mangled names are demangled and matched against the input streams of libstdc++ and libc++ (see classifyCxxFunction).
+ * - Both answers are cached per function (see classifyFunction), so the check costs the same for C and C++ calls.
+ */
+
+bool llvm::isInputFunction(const Function* F) {
+    return classifyFunction(F).input;
+}
+
+
+namespace {
+
+    /**
+     * Function: findDbgDeclare
+     * 
+     * Description:
+     * This function searches for a 'DbgDeclareInst' instance associated with a specific LLVM Value within a given function. 
+     * 'DbgDeclareInst' is an LLVM instruction used in debugging information to connect a variable with its storage location. 
+     * This function is particularly useful in analyzing variables' declarations and their metadata, which can include information such as the variable's name and line number in the source code.
+     * 
+     * Inputs:
+     * - Value* value: The LLVM Value for which the corresponding 'DbgDeclareInst' is being searched. This value typically represents a variable or a memory location.
+     * - Function &F: The LLVM Function within which the search is conducted. It contains the basic blocks and instructions to be inspected.
+     * 
+     * Output:
+     * - Returns a pointer to the found 'DbgDeclareInst' if the corresponding declaration instruction for the input value is found within the function.
+     * - Returns nullptr if no corresponding 'DbgDeclareInst' is found.
+     * 
+     * Implementation Details:
+     * - The function iterates through each basic block (BB) of the function.
+     * - In each basic block, it inspects each instruction (I).
+     * - If the instruction is a 'DbgDeclareInst' and its associated address matches the input value, the function returns this 'DbgDeclareInst'.
+     * - If no matching 'DbgDeclareInst' is found in the entire function, the function returns nullptr.
+     */
+
+    DbgDeclareInst* findDbgDeclare(Value* value, Function &F) {
+        for (auto &BB : F) {
+            for (auto &I : BB) {
+                if (DbgDeclareInst *DbgDeclare = dyn_cast<DbgDeclareInst>(&I)) {
+                    if (DbgDeclare->getAddress() == value) {
+                        return DbgDeclare;
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Rough cost of one entry of the walk containers: a std::set node holds the value, three links and the color; an
+    // unordered_map node holds the key, a VariableInfo and the bucket link.
+    constexpr uint64_t VisitedEntryBytes = sizeof(Value *) + 4 * sizeof(void *);
+    constexpr uint64_t VariableEntryBytes = sizeof(std::pair<const std::string, VariableInfo>) + sizeof(void *);
+
+    // What the analyses of the module being visited on this thread have used so far; see visitModuleSeminalFeatures.
+    struct ModuleBudget {
+        Clock::time_point start = Clock::now();
+        uint64_t steps = 0;
+        uint64_t bytes = 0;                   // estimated size of the results retained for the module
+    };
+
+    thread_local ModuleBudget *currentModuleBudget = nullptr;
+
+    // Work limits of the def-use walks of one function. A limit of 0 is no limit. Once a limit is hit every later
+    // charge fails, so the recursive walks unwind without visiting anything more. The walks of a function may run on
+    // several threads (see -seminal-function-threads), which all charge the same budget.
+    class AnalysisBudget {
+    public:
+        std::atomic<uint64_t> steps{0};
+
+        AnalysisBudget();
+
+        bool exhausted() const { return reasonHit.load(std::memory_order_relaxed) != nullptr; }
+
+        // Which limit was hit, empty if none.
+        std::string reason() const {
+            const char *why = reasonHit.load(std::memory_order_relaxed);
+            return why ? why : "";
+        }
+
+        // Counts one step of a walk whose visited set and variable map have the given sizes.
+        bool charge(size_t visitedEntries, size_t variableEntries) {
+            if (exhausted()) {
+                return false;
+            }
+            uint64_t step = steps.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (maxSteps && step > maxSteps) {
+                return exceed(stepReason);
+            }
+            if (maxBytes && visitedEntries * VisitedEntryBytes + variableEntries * VariableEntryBytes > maxBytes) {
+                return exceed(memoryReason);
+            }
+            // Reading the clock on every step would cost more than the step itself.
+            if (step % 256 == 0) {
+                return checkDeadline();
+            }
+            return true;
+        }
+
+        bool checkDeadline() {
+            if (!exhausted() && deadline && Clock::now() > *deadline) {
+                return exceed(timeReason);
+            }
+            return !exhausted();
+        }
+
+    private:
+        uint64_t maxSteps = 0;
+        uint64_t maxBytes = 0;
+        std::optional<Clock::time_point> deadline;
+        const char *stepReason = "step budget exceeded";
+        const char *memoryReason = "memory budget exceeded";
+        const char *timeReason = "time budget exceeded";
+        std::atomic<const char *> reasonHit{nullptr};   // the first limit hit
+
+        bool exceed(const char *why) {
+            const char *none = nullptr;
+            reasonHit.compare_exchange_strong(none, why, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Lowers limit to what is left of a module budget, which then becomes the reason given if it is hit.
+        void tighten(uint64_t &limit, const char *&limitReason, uint64_t moduleLimit, uint64_t used, const char *moduleReason) {
+            if (!moduleLimit) {
+                return;
+            }
+            if (used >= moduleLimit) {
+                exceed(moduleReason);
+                return;
+            }
+            if (!limit || moduleLimit - used < limit) {
+                limit = moduleLimit - used;
+                limitReason = moduleReason;
+            }
+        }
+    };
+
+    // Starts from the -seminal-function-*-budget limits, lowered to what is left of the module's budgets when the
+    // function is analyzed from visitModuleSeminalFeatures.
+    AnalysisBudget::AnalysisBudget() : maxSteps(FunctionStepBudget), maxBytes(uint64_t(FunctionMemoryBudget) << 20) {
+        Clock::time_point now = Clock::now();
+        if (FunctionTimeBudget) {
+            deadline = now + std::chrono::milliseconds(FunctionTimeBudget);
+        }
+        const ModuleBudget *module = currentModuleBudget;
+        if (!module) {
+            return;
+        }
+        tighten(maxSteps, stepReason, ModuleStepBudget, module->steps, "module step budget exceeded");
+        tighten(maxBytes, memoryReason, uint64_t(ModuleMemoryBudget) << 20, module->bytes, "module memory budget exceeded");
+        if (ModuleTimeBudget) {
+            Clock::time_point moduleDeadline = module->start + std::chrono::milliseconds(ModuleTimeBudget);
+            if (now > moduleDeadline) {
+                exceed("module time budget exceeded");
+            } else if (!deadline || moduleDeadline < *deadline) {
+                deadline = moduleDeadline;
+                timeReason = "module time budget exceeded";
+            }
+        }
+    }
+
+    // Estimated memory held by a result, for -seminal-module-memory-budget.
+    uint64_t estimatedResultBytes(const SeminalFeatureInfo &info) {
+        uint64_t bytes = sizeof(SeminalFeatureInfo) + info.sources.capacity() * sizeof(const CallBase *);
+        for (const SeminalFeature &feature : info.features) {
+            bytes += sizeof(SeminalFeature) + feature.name.capacity() +
+                     (feature.sources.capacity() + feature.origins.capacity()) * sizeof(const CallBase *);
+        }
+        // Control points share their interned sets, which are counted once.
+        SmallPtrSet<const void *, 16> counted;
+        for (const auto *points : {&info.loops, &info.branches}) {
+            for (const SeminalControlPoint &point : *points) {
+                bytes += sizeof(SeminalControlPoint);
+                if (counted.insert(point.sources.identity()).second) {
+                    bytes += sizeof(std::vector<const CallBase *>) + point.sources.elements().capacity() * sizeof(const CallBase *);
+                }
+                if (counted.insert(point.variables.identity()).second) {
+                    bytes += sizeof(std::vector<std::string>);
+                    for (const std::string &name : point.variables) {
+                        bytes += sizeof(std::string) + name.capacity();
+                    }
+                }
+            }
+        }
+        for (const SeminalDispatch &dispatch : info.dispatches) {
+            bytes += sizeof(SeminalDispatch) + dispatch.targets.capacity() * sizeof(const Function *) +
+                     dispatch.sources.size() * sizeof(const CallBase *);
+            for (const std::string &name : dispatch.variables) {
+                bytes += sizeof(std::string) + name.capacity();
+            }
+        }
+        return bytes;
+    }
+
+    // Estimated memory held by a JSON value: the value itself, the heap storage of strings, arrays and objects, and an
+    // ordered map node per object member.
+    uint64_t estimatedJsonBytes(const Json &value) {
+        uint64_t bytes = sizeof(Json);
+        if (value.is_string()) {
+            bytes += sizeof(Json::string_t) + value.get_ref<const Json::string_t &>().capacity();
+        } else if (value.is_array()) {
+            const Json::array_t &elements = value.get_ref<const Json::array_t &>();
+            bytes += sizeof(Json::array_t) + (elements.capacity() - elements.size()) * sizeof(Json);
+            for (const Json &element : elements) {
+                bytes += estimatedJsonBytes(element);
+            }
+        } else if (value.is_object()) {
+            bytes += sizeof(Json::object_t);
+            for (const auto &member : value.get_ref<const Json::object_t &>()) {
+                bytes += 4 * sizeof(void *) + sizeof(Json::string_t) + member.first.capacity() + estimatedJsonBytes(member.second);
+            }
+        }
+        return bytes;
+    }
+
+    // Per-function state shared by the def-use walks, which may run on several threads (see forEachWalk).
+    struct WalkContext {
+        AAResults *AA = nullptr;              // with alias analysis, loads are followed into the writers that may modify them
+        std::vector<Instruction *> writers;   // stores and calls that may write memory, in function order; only with AA
+        bool ssaVariables = false;            // optimized IR: variables are SSA values described by dbg.value, not allocas
+        AnalysisBudget *budget = nullptr;     // charged by every step of the walks, if set
+        const GlobalInputSummary *globals = nullptr;  // globals written with input anywhere in the module, if known
+        DenseMap<const Value *, DbgDeclareInst *> declarations;  // the first dbg.declare of each address
+
+        // One pass over F collects its dbg.declares, so that naming an address is a lookup instead of findDbgDeclare's scan.
+        WalkContext(Function &F, AAResults *AA, bool ssaVariables) : AA(AA), ssaVariables(ssaVariables) {
+            for (Instruction &I : instructions(F)) {
+                if (auto *DbgDeclare = dyn_cast<DbgDeclareInst>(&I)) {
+                    if (DbgDeclare->getVariable()) {
+                        declarations.try_emplace(DbgDeclare->getAddress(), DbgDeclare);
+                    }
+                } else if (AA && I.mayWriteToMemory() && !isa<DbgInfoIntrinsic>(&I)) {
+                    writers.push_back(&I);
+                }
+            }
+        }
+
+        DbgDeclareInst *declarationOf(const Value *address) const {
+            auto it = declarations.find(address);
+            return it == declarations.end() ? nullptr : it->second;
+        }
+
+        // The writers that may modify what Load reads, in function order, or nullptr if the budget ran out while they
+        // were queried. Each load is queried once and the answer shared by every walk reaching it. Queries hold a lock:
+        // alias analysis, and the DominatorTree and AssumptionCache it consults, update caches of their own. Every
+        // alias query is charged as a step, since it is where loads in large functions spend their time.
+        const std::vector<Instruction *> *modifiersOf(LoadInst *Load, size_t visitedEntries, size_t variableEntries) const {
+            std::lock_guard<std::mutex> lock(aliasMutex);
+            auto it = modifiers.find(Load);
+            if (it != modifiers.end()) {
+                return &it->second;
+            }
+            std::vector<Instruction *> found;
+            MemoryLocation loc = MemoryLocation::get(Load);
+            for (Instruction *writer : writers) {
+                if (budget && !budget->charge(visitedEntries, variableEntries)) {
+                    return nullptr;
+                }
+                if (isModSet(AA->getModRefInfo(writer, loc))) {
+                    found.push_back(writer);
+                }
+            }
+            // Node-based, so the returned vector stays put while other walks add loads.
+            return &modifiers.emplace(Load, std::move(found)).first->second;
+        }
+
+        // Whether CI may read memory through its pointer argument argNo.
+        bool readsArgument(CallBase *CI, unsigned argNo) const {
+            std::lock_guard<std::mutex> lock(aliasMutex);
+            auto inserted = argumentReads.try_emplace({CI, argNo}, false);
+            if (inserted.second) {
+                inserted.first->second = isRefSet(AA->getArgModRefInfo(CI, argNo));
+            }
+            return inserted.first->second;
+        }
+
+    private:
+        mutable std::mutex aliasMutex;
+        mutable std::unordered_map<const LoadInst *, std::vector<Instruction *>> modifiers;
+        mutable DenseMap<std::pair<const CallBase *, unsigned>, bool> argumentReads;
+    };
+
+#if LLVM_VERSION_MAJOR >= 19
+    using WalkThreadPool = DefaultThreadPool;
+#else
+    using WalkThreadPool = ThreadPool;
+#endif
+
+    // The pool installed by shareSeminalWalkThreads, and its number of threads. It is set before any analysis starts.
+    std::unique_ptr<WalkThreadPool> sharedWalkPool;
+    unsigned sharedWalkThreads = 0;
+
+    // The pool whose threads help the calling thread with a function's walks, and how many threads the walks may
+    // use in all, the caller included; nullptr when they stay on the calling thread. An explicit
+    // -seminal-function-threads gets a pool of its own, created once, so its threads and their caches are kept.
+    WalkThreadPool *walkPool(unsigned &threads) {
+        if (FunctionThreads.getNumOccurrences() == 0 && sharedWalkPool) {
+            threads = sharedWalkThreads + 1;
+            return sharedWalkPool.get();
+        }
+        threads = FunctionThreads ? FunctionThreads : std::max(1u, std::thread::hardware_concurrency());
+        if (threads <= 1) {
+            return nullptr;
+        }
+        static WalkThreadPool pool(hardware_concurrency(threads - 1));
+        return &pool;
+    }
+
+    // What the helpers of one forEachWalk call share. A helper task may start after the call has finished every walk,
+    // when the pool was busy with other callers' walks; it then finds the batch closed and returns without touching
+    // the caller's state.
+    struct WalkBatch {
+        std::mutex mutex;
+        std::condition_variable idle;
+        unsigned running = 0;
+        bool closed = false;
+    };
+
+    /**
+     * Function: forEachWalk
+     *
+     * Description:
+     * Runs walk(0) ... walk(count - 1), independent def-use walks of one function. The walks only read the IR and share
+     * the WalkContext, so once there are at least -seminal-parallel-walks of them they are spread over the threads of
+     * walkPool and the calling one, each taking the next index from a shared counter. The caller does not wait for
+     * helpers that have not started by the time it runs out of walks, so a busy shared pool never holds it up.
+     * Every walk writes only its own slot of the caller's results, which the caller merges in index order, so the result
+     * does not depend on the number of threads. With -seminal-memory-report each thread charges an account of its own,
+     * and their peaks are added to the caller's account as if they coincided.
+     */
+
+    void forEachWalk(size_t count, function_ref<void(size_t)> walk) {
+        unsigned threads = 1;
+        WalkThreadPool *pool = walkPool(threads);
+        threads = std::min<size_t>(threads, count);
+        if (!pool || threads <= 1 || count < ParallelWalkThreshold) {
+            for (size_t i = 0; i < count; ++i) {
+                walk(i);
+            }
+            return;
+        }
+
+        MemoryAccount *account = currentMemoryAccount;
+        std::vector<MemoryAccount> accounts(threads);
+        std::atomic<size_t> next{0};
+        auto work = [&](unsigned id) {
+            MemoryAccount *outer = currentMemoryAccount;
+            currentMemoryAccount = account ? &accounts[id] : nullptr;
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                walk(i);
+            }
+            currentMemoryAccount = outer;
+        };
+        auto batch = std::make_shared<WalkBatch>();
+        for (unsigned id = 1; id < threads; ++id) {
+            (void)pool->async([batch, &work, id] {
+                {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    if (batch->closed) {
+                        return;
+                    }
+                    ++batch->running;
+                }
+                work(id);
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                --batch->running;
+                batch->idle.notify_all();
+            });
+        }
+        work(0);
+        {
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->closed = true;
+            batch->idle.wait(lock, [&] { return batch->running == 0; });
+        }
+        if (account) {
+            account->addConcurrentPeaks(accounts);
+        }
+    }
+
+    // Source line for a variable recovered in optimized IR: its declaration line, else the nearest debug location.
+    int ssaVariableLine(const Value *V, const DILocalVariable *Var) {
+        if (Var && Var->getLine()) {
+            return Var->getLine();
+        }
+        if (const auto *I = dyn_cast<Instruction>(V)) {
+            for (const Instruction &J : *I->getParent()) {
+                if (J.getDebugLoc()) {
+                    return J.getDebugLoc().getLine();
+                }
+            }
+        } else if (const auto *A = dyn_cast<Argument>(V)) {
+            if (const DISubprogram *SP = A->getParent()->getSubprogram()) {
+                return SP->getLine();
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Function: findSSAVariable
+     *
+     * Description:
+     * Recovers the source variable an SSA value stands for in optimized IR, where variables live in registers instead of
+     * allocas described by dbg.declare:
+     * - any debug user of V gives the variable: dbg.value (and, from LLVM 19, #dbg_value records) for registers, dbg.declare,
+     *   dbg.assign or #dbg_declare for allocas that survived optimization;
+     * - otherwise arguments, PHI nodes and the allocas of address-taken locals fall back to their SSA names, without the
+     *   numeric suffixes LLVM adds on collisions ("i.05" becomes "i"), so IR built without -g still reports loop counters,
+     *   parameters and the variables input is read into.
+     *
+     * Output:
+     * - Returns true and fills 'info' if V stands for a source variable.
+     */
+
+    bool findSSAVariable(Value *V, VariableInfo &info) {
+        if (isa<Constant>(V) || isa<MetadataAsValue>(V)) {
+            return false;
+        }
+        const DILocalVariable *Var = nullptr;
+        SmallVector<DbgVariableIntrinsic *, 2> dbgUsers;
+#if LLVM_VERSION_MAJOR >= 19
+        SmallVector<DbgVariableRecord *, 2> dbgRecords;
+        findDbgUsers(dbgUsers, V, &dbgRecords);
+        if (!dbgRecords.empty()) {
+            Var = dbgRecords.front()->getVariable();
+        }
+#else
+        findDbgUsers(dbgUsers, V);
+#endif
+        if (!Var && !dbgUsers.empty()) {
+            Var = dbgUsers.front()->getVariable();
+        }
+        if (Var) {
+            info = VariableInfo(Var->getName().str(), ssaVariableLine(V, Var), nullptr, V);
+            return true;
+        }
+
+        if ((isa<Argument>(V) || isa<PHINode>(V) || isa<AllocaInst>(V)) && V->hasName()) {
+            StringRef name = V->getName();
+            while (true) {
+                size_t dot = name.rfind('.');
+                if (dot == StringRef::npos || dot == 0 || name.size() == dot + 1 ||
+                    name.find_first_not_of("0123456789", dot + 1) != StringRef::npos) {
+                    break;
+                }
+                name = name.take_front(dot);
+            }
+            info = VariableInfo(name.str(), ssaVariableLine(V, nullptr), nullptr, V);
+            return true;
+        }
+        return false;
+    }
+
+    // The global variable 'pointer' points into when input is stored into it somewhere in the module, named after its
+    // DIGlobalVariable (or its symbol without debug info).
+    const GlobalVariable *inputGlobal(const Value *pointer, const GlobalInputSummary *globals, VariableInfo &info) {
+        const auto *GV = globals ? dyn_cast<GlobalVariable>(getUnderlyingObject(pointer)) : nullptr;
+        if (!GV || !globals->lookup(GV)) {
+            return nullptr;
+        }
+        SmallVector<DIGlobalVariableExpression *, 1> expressions;
+        GV->getDebugInfo(expressions);
+        if (!expressions.empty() && expressions.front()->getVariable()) {
+            const DIGlobalVariable *Var = expressions.front()->getVariable();
+            info = VariableInfo(Var->getName().str(), Var->getLine(), nullptr, GV);
+        } else {
+            info = VariableInfo(GV->getName().str(), 0, nullptr, GV);
+        }
+        return GV;
+    }
+
+    // Records the variable V stands for, through dbg.declare at -O0 or findSSAVariable in optimized IR. The name is
+    // also returned through 'name' when given.
+    bool recordVariable(Value *V, Function &F, const WalkContext *context, VariableMap &variableMap, std::string *name = nullptr) {
+        VariableInfo info;
+        if (context && context->ssaVariables) {
+            // findDbgUsers also sees dbg.declare, without scanning the function for it.
+            if (!findSSAVariable(V, info)) {
+                return false;
+            }
+        } else {
+            DbgDeclareInst *DbgDeclare = context ? context->declarationOf(V) : findDbgDeclare(V, F);
+            if (!DbgDeclare || !DbgDeclare->getVariable()) {
+                return false;
+            }
+            info = VariableInfo(DbgDeclare->getVariable()->getName().str(), DbgDeclare->getDebugLoc().getLine(), DbgDeclare);
+        }
+        if (name) {
+            *name = info.name;
+        }
+        variableMap[info.name] = info;
+        return true;
+    }
+    /**
+     * Function: trackDefUseChain
+     * 
+     * Description:
+     * This function recursively tracks the definition-use chain of a given LLVM Value within a function. It is designed to analyze the flow and dependencies of variables, identifying where they are defined and used. This analysis helps in understanding how different variables interact within the program, especially regarding their influence on key execution points like loops and conditional statements.
+     * 
+     * The function explores various types of instructions, such as Load, Store, and Call, to trace variables' origins and usages. It maintains a map of variable information, recording the name and line number of each variable encountered in the def-use chain. This map is later used to identify seminal input features of the function.
+     * 
+     * Inputs:
+     * - Value *value: The initial LLVM Value (variable or instruction) from which the def-use chain tracking starts.
+     * - VisitedSet &visited: A set to keep track of visited Values, avoiding redundant analysis.
+     * - VariableMap &variableMap: A map to store information about each variable encountered during the tracking process.
+     * - Function &F: The LLVM Function within which the analysis is conducted.
+     * - const WalkContext *context: Optional per-function context. With alias analysis, the walk continues through memory, but only into the writers that may modify what is read; in optimized IR, every value reached is also named through findSSAVariable.
+     * 
+     * Outputs:
+     * The function updates the 'variableMap' with information about the variables found along the def-use chain. It does not return any value.
+     * 
+     * Implementation Details:
+     * - The function handles LoadInst by tracking the value loaded and adding its information to the map. With alias analysis, the stores and calls whose getModRefInfo on the loaded location includes Mod are tracked as well.
+     *   A load from a global that other functions write input into (the context's GlobalInputSummary) adds the global.
+     * - For StoreInst, both the value being stored and the location where it is stored are tracked; with alias analysis only the value, since the destination is not a source of the data.
+     * - Calls and invokes are handled by tracking both the return value (if any) and the arguments of the function call. With alias analysis, pointer arguments are followed only if the call may read through them, so buffers handed to printf-like sinks or memset destinations are not pulled in.
+     *   A call of size, length or empty of a std::string or std::vector also records the container it is given.
+     * - Recursion is used to explore all operands of an instruction, ensuring comprehensive coverage of the def-use chain. In optimized IR this includes the incoming values of PHI nodes.
+     */
+
+    void trackDefUseChain(Value *value, VisitedSet &visited, VariableMap &variableMap, Function &F, const WalkContext *context = nullptr) {
+        if (!visited.insert(value).second) {
+            return; 
+        }
+        if (context && context->budget && !context->budget->charge(visited.size(), variableMap.size())) {
+            return;
+        }
+        if (context && context->ssaVariables) {
+            recordVariable(value, F, context, variableMap);
+        }
+
+        if (Instruction *inst = dyn_cast<Instruction>(value)) {
+            if (LoadInst *LoadInstVar = dyn_cast<LoadInst>(inst)) {
+                Value *loadedValue = LoadInstVar->getPointerOperand();
+               // errs() << "LoadInst found, tracking: " << *loadedValue << "\n";
+                // In optimized IR the address is named when the walk reaches it below.
+                DbgDeclareInst *DbgDeclare = !context ? findDbgDeclare(loadedValue, F)
+                                             : context->ssaVariables ? nullptr : context->declarationOf(loadedValue);
+                if (DbgDeclare && DbgDeclare->getVariable()) {
+                    std::string varName = DbgDeclare->getVariable()->getName().str();
+                    int lineNo = DbgDeclare->getDebugLoc().getLine();
+                  //  errs() << "Variable found from LoadInst: " << varName << " at line " << lineNo << "\n";
+                    variableMap[varName] = VariableInfo(varName, lineNo, DbgDeclare);
+                }
+                VariableInfo global;
+                if (context && inputGlobal(loadedValue, context->globals, global)) {
+                    variableMap[global.name] = global;
+                }
+                trackDefUseChain(loadedValue, visited, variableMap, F, context);
+                if (context && context->AA) {
+                    if (const std::vector<Instruction *> *writers =
+                            context->modifiersOf(LoadInstVar, visited.size(), variableMap.size())) {
+                        for (Instruction *writer : *writers) {
+                            trackDefUseChain(writer, visited, variableMap, F, context);
+                        }
+                    }
+                }
+            } else if (StoreInst *StoreInstVar = dyn_cast<StoreInst>(inst)) {
+                Value *storedValue = StoreInstVar->getValueOperand();
+                Value *storedLocation = StoreInstVar->getPointerOperand();
+               
+                trackDefUseChain(storedValue, visited, variableMap, F, context);
+                if (!context || !context->AA) {
+                    trackDefUseChain(storedLocation, visited, variableMap, F, context);
+                }
+            } else if (CallBase *CI = dyn_cast<CallBase>(inst)) {
+          
+                if (CI->getType() != Type::getVoidTy(F.getContext())) {
+                  
+                    trackDefUseChain(CI, visited, variableMap, F, context);  
+                }
+
+                // The size of a std::string or std::vector reads the container, which is passed by address.
+                if (CI->arg_size() > 0 && classifyFunction(CI->getCalledFunction()).containerSize) {
+                    recordVariable(CI->getArgOperand(0)->stripPointerCasts(), F, context, variableMap);
+                }
+
+                for (auto arg = CI->arg_begin(); arg != CI->arg_end(); ++arg) {
+                    Value *argValue = *arg;
+                    if (context && context->AA && argValue->getType()->isPointerTy() &&
+                        !context->readsArgument(CI, CI->getArgOperandNo(arg))) {
+                        continue;
+                    }
+                    trackDefUseChain(argValue, visited, variableMap, F, context);  
+                }
+                
+            } else {
+                for (unsigned i = 0; i < inst->getNumOperands(); ++i) {
+                    trackDefUseChain(inst->getOperand(i), visited, variableMap, F, context);
+                }
+            }
+        }
+    }
+
+
+
+
+    void analyzeTerminator(Value *value, VisitedSet &visited, VariableMap &variableMap, Function &F, const WalkContext *context = nullptr) {
+    
+        if (Instruction *inst = dyn_cast<Instruction>(value)) {
+           
+            for (unsigned i = 0; i < inst->getNumOperands(); ++i) {
+               
+                trackDefUseChain(inst->getOperand(i), visited,variableMap, F, context);
+            }
+        }
+    }
+    void analyzeLoop(Loop *loop,VisitedSet &visited, VariableMap &variableMap,Function &F, const WalkContext *context = nullptr) {
+        
+        BasicBlock *header = loop->getHeader();
+        for (auto &I : *header) {
+            if (auto *BI = dyn_cast<BranchInst>(&I)) {
+                if (BI->isConditional()) {
+                   
+                    analyzeTerminator(BI->getCondition(), visited, variableMap, F, context);
+                }
+            }
+        }
+    }
+
+    /**
+     * Function: recordIOVariable
+     *
+     * Description:
+     * Records the source variable whose storage is 'location' (an alloca described by a dbg.declare, or in optimized IR any value
+     * findSSAVariable names) as a variable written by the input call 'source'.
+     *
+     * Output:
+     * - Returns true if 'location' maps to a named source variable, which is added to both 'variableMap' and 'ioVariables'.
+     */
+
+    bool recordIOVariable(Value *location, const CallBase *source, Function &F, const WalkContext *context, VariableMap &variableMap, IOVariableMap &ioVariables) {
+        std::string varName;
+        if (recordVariable(location, F, context, variableMap, &varName)) {
+            ioVariables[varName].push_back(source);
+            return true;
+        }
+        return false;
+    }
+
+    // Records the variable the result of CI is stored into, for calls such as fopen whose return value is the input.
+    // The result of an invoke is stored in its normal destination. Optimized IR keeps the result in a register, which
+    // is named directly.
+    void recordStoredIOVariable(CallBase *CI, const WalkContext *context, VariableMap &variableMap, IOVariableMap &ioVariables, Function &F) {
+        auto *II = dyn_cast<InvokeInst>(CI);
+        BasicBlock *BB = II ? II->getNormalDest() : CI->getParent();
+        for (auto iter = II ? BB->begin() : CI->getIterator(); iter != BB->end(); ++iter) {
+            if (StoreInst *SI = dyn_cast<StoreInst>(&*iter)) {
+                if (SI->getValueOperand() == CI && recordIOVariable(SI->getPointerOperand(), CI, F, context, variableMap, ioVariables)) {
+                    return;
+                }
+            }
+        }
+        if (context && context->ssaVariables) {
+            recordIOVariable(CI, CI, F, context, variableMap, ioVariables);
+        }
+    }
+
+    // Records the variables written by a call of an input function: the variable fopen's stream is stored into, the
+    // stream object a file stream constructor or open sets up, and otherwise every variable passed to the call.
+    void recordInputCall(CallBase *CI, const WalkContext *context, VariableMap &variableMap, IOVariableMap &ioVariables, Function &F) {
+        LibraryFunction input = classifyFunction(CI->getCalledFunction());
+        if (input.opensStream && input.returnsInput) {
+            recordStoredIOVariable(CI, context, variableMap, ioVariables, F);
+        } else if (input.opensStream) {
+            if (CI->arg_size() > input.firstArgument) {
+                recordIOVariable(CI->getArgOperand(input.firstArgument)->stripPointerCasts(), CI, F, context, variableMap, ioVariables);
+            }
+        } else {
+            for (Value *arg : CI->args()) {
+                recordIOVariable(arg, CI, F, context, variableMap, ioVariables);
+            }
+        }
+    }
+
+    /**
+     * Function: applyCallSummary
+     *
+     * Description:
+     * Applies the summary of a callee (see FeatureSummary.h) to a call of it: the summary of a function defined in the module under
+     * the call string of the call, or the imported summary of a function defined in another module, so input read by callees
+     * reaches this function without inlining or linking them in:
+     * - a callee that returns input behaves like fopen: the variable its result is stored into is an IO variable;
+     * - a callee that writes input through pointer parameters behaves like scanf for those arguments;
+     * - variables passed to parameters that bound a loop in the callee are recorded as influencing that loop.
+     */
+
+    void applyCallSummary(CallBase *CI, const FunctionFeatureSummary &summary, const WalkContext *context, VariableMap &variableMap, IOVariableMap &ioVariables, Function &F) {
+        if (summary.returnsInput) {
+            recordStoredIOVariable(CI, context, variableMap, ioVariables, F);
+        }
+        for (unsigned argNo : summary.inputParams) {
+            if (argNo < CI->arg_size()) {
+                recordIOVariable(CI->getArgOperand(argNo), CI, F, context, variableMap, ioVariables);
+            }
+        }
+        for (unsigned argNo : summary.loopParams) {
+            if (argNo >= CI->arg_size()) {
+                continue;
+            }
+            if (LoadInst *Load = dyn_cast<LoadInst>(CI->getArgOperand(argNo))) {
+                recordVariable(Load->getPointerOperand(), F, context, variableMap);
+            } else if (context && context->ssaVariables) {
+                recordVariable(CI->getArgOperand(argNo), F, context, variableMap);
+            }
+        }
+    }
+
+    // Whether F is analyzed as optimized IR, see -seminal-optimized-ir.
+    bool usesSSAVariables(Function &F) {
+        if (OptimizedIR != cl::BOU_UNSET) {
+            return OptimizedIR == cl::BOU_TRUE;
+        }
+        return llvm::none_of(instructions(F), [](Instruction &I) { return isa<DbgDeclareInst>(&I); });
+    }
+
+    // The object whose memory 'pointer' points into, or nullptr when it cannot be identified.
+    const Value *memoryCell(const Value *pointer) {
+        const Value *object = getUnderlyingObject(pointer);
+        return isa<AllocaInst>(object) || isa<GlobalVariable>(object) || isa<Argument>(object) ? object : nullptr;
+    }
+
+    /**
+     * Class: SetPool
+     *
+     * Description:
+     * Hash-consing table for the InternedSets of one function's result. A set is stored once however many control points
+     * hold it, and unions are memoized by the identities of their operands, so merging two sets that were merged before,
+     * or a set with itself or the empty set, costs a lookup or a pointer compare instead of a walk over both.
+     */
+
+    template <typename T> class SetPool {
+    public:
+        // The interned copy of 'elements', which must already be in the set's order (sorted names, input calls in
+        // function order) and without duplicates.
+        InternedSet<T> intern(std::vector<T> elements) {
+            if (elements.empty()) {
+                return InternedSet<T>();
+            }
+            auto &bucket = table[hash_combine_range(elements.begin(), elements.end())];
+            for (const auto &candidate : bucket) {
+                if (*candidate == elements) {
+                    return InternedSet<T>(candidate);
+                }
+            }
+            bucket.push_back(std::make_shared<const std::vector<T>>(std::move(elements)));
+            return InternedSet<T>(bucket.back());
+        }
+
+        // Union of two sorted sets.
+        InternedSet<T> unite(const InternedSet<T> &a, const InternedSet<T> &b) {
+            if (a.identity() == b.identity() || b.empty()) {
+                return a;
+            }
+            if (a.empty()) {
+                return b;
+            }
+            auto key = std::minmax(a.identity(), b.identity());
+            auto it = unions.find(key);
+            if (it != unions.end()) {
+                return it->second;
+            }
+            std::vector<T> merged;
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+            InternedSet<T> result = intern(std::move(merged));
+            unions.try_emplace(key, result);
+            return result;
+        }
+
+    private:
+        std::unordered_map<size_t, SmallVector<std::shared_ptr<const std::vector<T>>, 1>> table;   // by content hash
+        DenseMap<std::pair<const void *, const void *>, InternedSet<T>> unions;
+    };
+
+    /**
+     * Class: InputTaint
+     *
+     * Description:
+     * Attributes the values and memory of a function to the input call sites they come from, in one forward propagation.
+     * The input calls (SeminalFeatureInfo::sources) are numbered in function order and the taint of a value is a BitVector
+     * over them, so every join (the operands of an instruction, the incoming values of a PHI, the stores into one
+     * object) is a word-wise OR covering 64 call sites at a time, however many there are.
+     * - An input call sets its bit on its result and on the memory it writes: the arguments after the format of the
+     *   scanf family, and the input parameters of the callee's summary.
+     * - Memory is tracked per underlying object (alloca, global or argument); pointers without an identifiable object
+     *   share one cell. Cells are flow-insensitive: a load gets everything ever stored into its object.
+     * - A global that other functions store input into (GlobalInputSummary) starts with the bits of their input calls,
+     *   which are numbered after the function's own.
+     * - Other calls pass the taint of their arguments, and of the memory those point to, to their result and, through
+     *   the pointer arguments they may write, to that memory.
+     * The worklist runs to a fixpoint and charges each instruction it processes to the budget.
+     *
+     * Taints are hash-consed like the sets of SetPool: most values of a large function carry one of a few distinct
+     * taints, which are stored once, and a join whose result was computed before is a lookup. A taint that does not
+     * change keeps its pointer, which is how the worklist sees that nothing changed.
+     */
+
+    class InputTaint {
+    public:
+        InputTaint(Function &F, ArrayRef<const CallBase *> sources, CallStringSummaries &callSummaries,
+                   const GlobalInputSummary *globals, AnalysisBudget *budget)
+            : sources(sources.begin(), sources.end()) {
+            for (Instruction &I : instructions(F)) {
+                if (isa<LoadInst>(&I)) {
+                    readers[memoryCell(cast<LoadInst>(&I)->getPointerOperand())].push_back(&I);
+                } else if (auto *CB = dyn_cast<CallBase>(&I)) {
+                    for (Value *arg : CB->args()) {
+                        if (arg->getType()->isPointerTy()) {
+                            readers[memoryCell(arg)].push_back(&I);
+                        }
+                    }
+                }
+            }
+            // The calls other functions store into the globals F reads get the bits after F's own calls.
+            std::vector<std::pair<const Value *, SmallVector<unsigned, 2>>> globalSeeds;
+            if (globals && globals->readsInput(&F)) {
+                DenseMap<const CallBase *, unsigned> numbers;
+                DenseSet<const Value *> seeded;
+                for (Instruction &I : instructions(F)) {
+                    auto *Load = dyn_cast<LoadInst>(&I);
+                    const auto *GV = Load ? dyn_cast_or_null<GlobalVariable>(memoryCell(Load->getPointerOperand())) : nullptr;
+                    const GlobalInputInfo *global = GV ? globals->lookup(GV) : nullptr;
+                    if (!global || !seeded.insert(GV).second) {
+                        continue;
+                    }
+                    SmallVector<unsigned, 2> bits;
+                    for (const CallBase *CI : global->sources) {
+                        if (CI->getFunction() == &F) {
+                            continue;
+                        }
+                        auto number = numbers.try_emplace(CI, this->sources.size());
+                        if (number.second) {
+                            this->sources.push_back(CI);
+                        }
+                        bits.push_back(number.first->second);
+                    }
+                    globalSeeds.emplace_back(GV, std::move(bits));
+                }
+            }
+            none = intern(BitVector(this->sources.size()));
+            for (unsigned i = 0; i < sources.size(); ++i) {
+                seed(i, callSummaries);
+            }
+            for (const auto &globalSeed : globalSeeds) {
+                BitVector bits(this->sources.size());
+                for (unsigned bit : globalSeed.second) {
+                    bits.set(bit);
+                }
+                join(cells, globalSeed.first, intern(std::move(bits)));
+            }
+
+            std::vector<Instruction *> worklist;
+            for (Instruction &I : instructions(F)) {
+                worklist.push_back(&I);
+            }
+            std::reverse(worklist.begin(), worklist.end());
+            DenseSet<Instruction *> queued(worklist.begin(), worklist.end());
+            auto requeue = [&](Instruction *I) {
+                if (queued.insert(I).second) {
+                    worklist.push_back(I);
+                }
+            };
+            while (!worklist.empty()) {
+                Instruction *I = worklist.back();
+                worklist.pop_back();
+                queued.erase(I);
+                if (budget && !budget->charge(values.size() + cells.size(), 0)) {
+                    return;
+                }
+                if (transfer(*I)) {
+                    for (User *U : I->users()) {
+                        if (auto *userInst = dyn_cast<Instruction>(U)) {
+                            requeue(userInst);
+                        }
+                    }
+                }
+                for (const Value *cell : changedCells) {
+                    auto it = readers.find(cell);
+                    if (it != readers.end()) {
+                        for (Instruction *reader : it->second) {
+                            requeue(reader);
+                        }
+                    }
+                }
+                changedCells.clear();
+            }
+        }
+
+        // The empty taint, to accumulate taints from with unite.
+        const BitVector *emptySet() const { return none; }
+
+        const BitVector *valueTaint(const Value *V) const {
+            auto it = values.find(V);
+            return it == values.end() ? none : it->second;
+        }
+
+        // The taint of the memory 'pointer' points into.
+        const BitVector *memoryTaint(const Value *pointer) const {
+            auto it = cells.find(memoryCell(pointer));
+            return it == cells.end() ? none : it->second;
+        }
+
+        const BitVector *unite(const BitVector *a, const BitVector *b) {
+            if (a == b || b == none) {
+                return a;
+            }
+            if (a == none) {
+                return b;
+            }
+            auto key = std::minmax(a, b);
+            auto it = unions.find(key);
+            if (it != unions.end()) {
+                return it->second;
+            }
+            BitVector merged = *a;
+            merged |= *b;
+            const BitVector *result = intern(std::move(merged));
+            unions.try_emplace(key, result);
+            return result;
+        }
+
+        // The input calls of 'taint', in function order.
+        InternedSet<const CallBase *> calls(const BitVector *taint) {
+            auto inserted = callSets.try_emplace(taint);
+            if (inserted.second) {
+                std::vector<const CallBase *> result;
+                for (unsigned i : taint->set_bits()) {
+                    result.push_back(sources[i]);
+                }
+                inserted.first->second = callPool.intern(std::move(result));
+            }
+            return inserted.first->second;
+        }
+
+    private:
+        std::vector<const CallBase *> sources;
+        const BitVector *none = nullptr;
+        std::deque<BitVector> taints;                       // every distinct taint, once
+        std::unordered_map<unsigned, SmallVector<const BitVector *, 1>> taintTable;  // by content hash
+        DenseMap<std::pair<const BitVector *, const BitVector *>, const BitVector *> unions;
+        DenseMap<const Value *, const BitVector *> values;
+        DenseMap<const Value *, const BitVector *> cells;   // by memoryCell; nullptr for unidentified memory
+        DenseMap<const Value *, SmallVector<Instruction *, 4>> readers;  // loads and calls reading each cell
+        SmallVector<const Value *, 4> changedCells;
+        DenseMap<const BitVector *, InternedSet<const CallBase *>> callSets;
+        SetPool<const CallBase *> callPool;
+
+        const BitVector *intern(BitVector taint) {
+            auto &bucket = taintTable[hash_combine_range(taint.set_bits_begin(), taint.set_bits_end())];
+            for (const BitVector *candidate : bucket) {
+                if (*candidate == taint) {
+                    return candidate;
+                }
+            }
+            taints.push_back(std::move(taint));
+            bucket.push_back(&taints.back());
+            return bucket.back();
+        }
+
+        // Joins 'taint' into map[key]; returns whether it grew.
+        bool join(DenseMap<const Value *, const BitVector *> &map, const Value *key, const BitVector *taint) {
+            const BitVector *&entry = map.try_emplace(key, none).first->second;
+            const BitVector *joined = unite(entry, taint);
+            if (joined == entry) {
+                return false;
+            }
+            entry = joined;
+            return true;
+        }
+
+        void joinCell(const Value *pointer, const BitVector *taint) {
+            const Value *cell = memoryCell(pointer);
+            if (join(cells, cell, taint)) {
+                changedCells.push_back(cell);
+            }
+        }
+
+        void seed(unsigned index, CallStringSummaries &callSummaries) {
+            const CallBase *CI = sources[index];
+            const Function *callee = CI->getCalledFunction();
+            BitVector bits(sources.size());
+            bits.set(index);
+            const BitVector *bit = intern(std::move(bits));
+            bool returnsInput = true;
+            LibraryFunction input = classifyFunction(callee);
+            if (input.input) {
+                returnsInput = input.returnsInput;
+                for (unsigned argNo = input.firstArgument; argNo < std::min(input.endArgument, CI->arg_size()); ++argNo) {
+                    if (CI->getArgOperand(argNo)->getType()->isPointerTy()) {
+                        joinCell(CI->getArgOperand(argNo), bit);
+                    }
+                }
+            } else if (const FunctionFeatureSummary *summary = callSummaries.lookup(CI)) {
+                returnsInput = summary->returnsInput;
+                for (unsigned argNo : summary->inputParams) {
+                    if (argNo < CI->arg_size()) {
+                        joinCell(CI->getArgOperand(argNo), bit);
+                    }
+                }
+            }
+            if (returnsInput && !CI->getType()->isVoidTy()) {
+                join(values, CI, bit);
+            }
+            changedCells.clear();
+        }
+
+        // Recomputes the taint of I; returns whether its own taint grew. Cells it grows are left in changedCells.
+        bool transfer(Instruction &I) {
+            if (isa<DbgInfoIntrinsic>(&I)) {
+                return false;
+            }
+            if (auto *Store = dyn_cast<StoreInst>(&I)) {
+                joinCell(Store->getPointerOperand(), valueTaint(Store->getValueOperand()));
+                return false;
+            }
+            const BitVector *taint = none;
+            if (auto *Load = dyn_cast<LoadInst>(&I)) {
+                taint = unite(memoryTaint(Load->getPointerOperand()), valueTaint(Load->getPointerOperand()));
+            } else if (auto *CB = dyn_cast<CallBase>(&I)) {
+                for (Value *arg : CB->args()) {
+                    taint = unite(taint, valueTaint(arg));
+                    if (arg->getType()->isPointerTy()) {
+                        taint = unite(taint, memoryTaint(arg));
+                    }
+                }
+                if (!CB->onlyReadsMemory() && taint != none) {
+                    for (unsigned argNo = 0; argNo < CB->arg_size(); ++argNo) {
+                        Value *arg = CB->getArgOperand(argNo);
+                        if (arg->getType()->isPointerTy() && !isa<Constant>(arg) && !CB->onlyReadsMemory(argNo)) {
+                            joinCell(arg, taint);
+                        }
+                    }
+                }
+            } else {
+                for (Value *operand : I.operands()) {
+                    taint = unite(taint, valueTaint(operand));
+                }
+            }
+            if (I.getType()->isVoidTy() || taint == none) {
+                return false;
+            }
+            return join(values, &I, taint);
+        }
+    };
+
+
+    // Names of the variables the roots depend on (the operands of a loop exit or branch condition, or the pointer an
+    // indirect call calls and the conditions choosing it), sorted and without duplicates.
+    void collectConditionVariables(ArrayRef<Value *> roots, Function &F, const WalkContext *context, std::vector<std::string> &variables) {
+        VisitedSet visited;
+        VariableMap conditionVariables;
+        for (Value *root : roots) {
+            trackDefUseChain(root, visited, conditionVariables, F, context);
+        }
+        for (const auto &entry : conditionVariables) {
+            variables.push_back(entry.first);
+        }
+        llvm::sort(variables);
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+    }
+
+    bool isConditionalTerminator(const Instruction *I) {
+        if (const auto *BI = dyn_cast_or_null<BranchInst>(I)) {
+            return BI->isConditional();
+        }
+        return isa_and_nonnull<SwitchInst>(I);
+    }
+
+    // Finds the variables a list of roots reads, for a control point or dispatch (see collectConditionVariables).
+    using ConditionVariables = function_ref<void(ArrayRef<Value *>, std::vector<std::string> &)>;
+
+    /**
+     * Function: collectControlPoints
+     *
+     * Description:
+     * Records every loop of F with the variables read by its exit conditions, and every other conditional branch or
+     * switch with the variables read by its condition, as found by 'conditionVariables' (collectConditionVariables, or
+     * the cheaper slice of a degraded analysis). Each condition is walked with its own visited set, so a variable
+     * is attributed to every condition that reads it, and the walks of a large function run in parallel (forEachWalk).
+     * With 'taint', each control point also gets the input calls whose data reaches the operands of its conditions.
+     *
+     * The variable sets are interned in a SetPool as each walk finishes, so the conditions of a large function, which
+     * mostly read the same few variables, share their sets instead of holding a copy each, and the loops that merge
+     * several exits get memoized unions.
+     */
+
+    void collectControlPoints(Function &F, LoopInfo &LI, ConditionVariables conditionVariables, InputTaint *taint, SeminalFeatureInfo &info) {
+        std::vector<SmallVector<Instruction *, 2>> loopConditions;
+        for (Loop *loop : LI.getLoopsInPreorder()) {
+            SeminalControlPoint loopPoint;
+            loopPoint.loop = loop;
+            SmallVector<Instruction *, 2> conditions;
+            SmallVector<BasicBlock *, 4> exitingBlocks;
+            loop->getExitingBlocks(exitingBlocks);
+            for (BasicBlock *BB : exitingBlocks) {
+                Instruction *terminator = BB->getTerminator();
+                if (!isConditionalTerminator(terminator)) {
+                    continue;
+                }
+                if (!loopPoint.terminator || BB == loop->getHeader()) {
+                    loopPoint.terminator = terminator;
+                }
+                conditions.push_back(terminator);
+            }
+            info.loops.push_back(std::move(loopPoint));
+            loopConditions.push_back(std::move(conditions));
+        }
+
+        for (BasicBlock &BB : F) {
+            Instruction *terminator = BB.getTerminator();
+            if (!isConditionalTerminator(terminator)) {
+                continue;
+            }
+            // A block that exits a loop also exits every loop nested inside it, so checking the innermost one suffices.
+            Loop *loop = LI.getLoopFor(&BB);
+            if (loop && loop->isLoopExiting(&BB)) {
+                continue;
+            }
+            SeminalControlPoint branchPoint;
+            branchPoint.terminator = terminator;
+            info.branches.push_back(std::move(branchPoint));
+        }
+
+        std::vector<std::pair<SeminalControlPoint *, Instruction *>> conditions;
+        for (size_t i = 0; i < info.loops.size(); ++i) {
+            for (Instruction *terminator : loopConditions[i]) {
+                conditions.emplace_back(&info.loops[i], terminator);
+            }
+        }
+        for (SeminalControlPoint &branch : info.branches) {
+            conditions.emplace_back(&branch, const_cast<Instruction *>(branch.terminator));
+        }
+        SetPool<std::string> pool;
+        std::mutex poolMutex;
+        std::vector<InternedSet<std::string>> variables(conditions.size());
+        forEachWalk(conditions.size(), [&](size_t i) {
+            std::vector<std::string> found;
+            Instruction *terminator = conditions[i].second;
+            conditionVariables(SmallVector<Value *, 4>(terminator->op_begin(), terminator->op_end()), found);
+            std::lock_guard<std::mutex> lock(poolMutex);
+            variables[i] = pool.intern(std::move(found));
+        });
+        // A loop with several exits reads the union of their conditions.
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            InternedSet<std::string> &merged = conditions[i].first->variables;
+            merged = pool.unite(merged, variables[i]);
+        }
+
+        if (!taint) {
+            return;
+        }
+        DenseMap<SeminalControlPoint *, const BitVector *> reached;
+        for (const auto &condition : conditions) {
+            const BitVector *&inputs = reached.try_emplace(condition.first, taint->emptySet()).first->second;
+            for (Value *operand : condition.second->operands()) {
+                inputs = taint->unite(inputs, taint->valueTaint(operand));
+            }
+        }
+        for (auto &entry : reached) {
+            entry.first->sources = taint->calls(entry.second);
+        }
+    }
+
+    /**
+     * Function: collectDispatches
+     *
+     * Description:
+     * Records every call of F through a function pointer that IndirectCallTargets gives more than one target, with the
+     * variables read by the called pointer and by the conditions choosing it, found by 'conditionVariables' as for
+     * control points. With 'taint', each dispatch also gets the input calls whose data reaches those values. A dispatch
+     * is input-selected when one does, or when one of its variables is a feature written by input, so collectDispatches
+     * runs after the features are known.
+     */
+
+    void collectDispatches(Function &F, const IndirectCallTargets &indirectCalls, ConditionVariables conditionVariables,
+                           InputTaint *taint, SeminalFeatureInfo &info) {
+        std::vector<SmallVector<Value *, 4>> roots;
+        for (Instruction &I : instructions(F)) {
+            auto *CB = dyn_cast<CallBase>(&I);
+            const IndirectCallInfo *resolved = CB ? indirectCalls.lookup(CB) : nullptr;
+            if (!resolved || resolved->targets.size() < 2) {
+                continue;
+            }
+            SeminalDispatch dispatch;
+            dispatch.call = CB;
+            dispatch.targets = resolved->targets;
+            info.dispatches.push_back(std::move(dispatch));
+            SmallVector<Value *, 4> dispatchRoots{CB->getCalledOperand()};
+            for (const Value *condition : resolved->conditions) {
+                dispatchRoots.push_back(const_cast<Value *>(condition));
+            }
+            roots.push_back(std::move(dispatchRoots));
+        }
+        SetPool<std::string> pool;
+        std::mutex poolMutex;
+        forEachWalk(roots.size(), [&](size_t i) {
+            std::vector<std::string> found;
+            conditionVariables(roots[i], found);
+            std::lock_guard<std::mutex> lock(poolMutex);
+            info.dispatches[i].variables = pool.intern(std::move(found));
+        });
+        for (size_t i = 0; i < roots.size(); ++i) {
+            SeminalDispatch &dispatch = info.dispatches[i];
+            if (taint) {
+                const BitVector *inputs = taint->emptySet();
+                for (Value *root : roots[i]) {
+                    inputs = taint->unite(inputs, taint->valueTaint(root));
+                }
+                dispatch.sources = taint->calls(inputs);
+            }
+            dispatch.inputSelected = !dispatch.sources.empty() || llvm::any_of(dispatch.variables, [&](const std::string &name) {
+                const SeminalFeature *feature = info.lookup(name);
+                return feature && feature->fromInput;
+            });
+        }
+    }
+
+    // Variable name -> names of the variables its value is stored into (or, in optimized IR, assigned to).
+    using NameSet = std::set<std::string, std::less<std::string>, AccountedAllocator<std::string, VariableMaps>>;
+    using ValueFlowMap = std::unordered_map<std::string, NameSet, std::hash<std::string>, std::equal_to<std::string>,
+                                            AccountedAllocator<std::pair<const std::string, NameSet>, VariableMaps>>;
+
+    // Records, for every store into a named variable, which variables the stored value was computed from. In optimized
+    // IR a variable is also assigned by every value findSSAVariable names (the values described by dbg.value and the
+    // PHI nodes joining them), so each of those is walked as a value written into its variable. The values written into
+    // one variable are walked together with one visited set, since their sources are merged anyway; variables are
+    // walked in parallel in large functions (forEachWalk).
+    ValueFlowMap collectValueFlow(Function &F, const WalkContext *context) {
+        // The variables written, in function order, with the values written.
+        std::vector<std::pair<std::string, std::vector<Value *>>> targets;
+        StringMap<size_t> targetIndex;
+        auto addTarget = [&](StringRef target, Value *written) {
+            auto inserted = targetIndex.try_emplace(target, targets.size());
+            if (inserted.second) {
+                targets.emplace_back(target.str(), std::vector<Value *>());
+            }
+            targets[inserted.first->second].second.push_back(written);
+        };
+        for (Instruction &I : instructions(F)) {
+            VariableInfo variable;
+            if (StoreInst *SI = dyn_cast<StoreInst>(&I)) {
+                // Allocas that survived optimization are described by dbg.declare, or by a dbg.value of their address.
+                DbgDeclareInst *DbgDeclare = context->declarationOf(SI->getPointerOperand());
+                if (DbgDeclare && DbgDeclare->getVariable()) {
+                    addTarget(DbgDeclare->getVariable()->getName(), SI->getValueOperand());
+                } else if (context->ssaVariables && findSSAVariable(SI->getPointerOperand(), variable)) {
+                    addTarget(variable.name, SI->getValueOperand());
+                }
+            } else if (context->ssaVariables && !I.getType()->isVoidTy() && !isa<AllocaInst>(I) &&
+                       !isa<DbgInfoIntrinsic>(I) && findSSAVariable(&I, variable)) {
+                addTarget(variable.name, &I);
+            }
+        }
+        // The variable each group of stores writes, and the variables their values come from.
+        std::vector<std::pair<std::string, std::vector<std::string>>> flows(targets.size());
+        forEachWalk(targets.size(), [&](size_t i) {
+            const std::string &target = targets[i].first;
+            VisitedSet visited;
+            VariableMap sources;
+            for (Value *stored : targets[i].second) {
+                trackDefUseChain(stored, visited, sources, F, context);
+            }
+            for (const auto &entry : sources) {
+                if (entry.first != target) {
+                    flows[i].second.push_back(entry.first);
+                }
+            }
+            flows[i].first = target;
+        });
+
+        ValueFlowMap flowsInto;
+        for (const auto &flow : flows) {
+            for (const std::string &source : flow.second) {
+                flowsInto[source].insert(flow.first);
+            }
+        }
+        return flowsInto;
+    }
+
+    /**
+     * Function: scoreFeatures
+     *
+     * Description:
+     * Scores each feature by the static hotness of the control points it controls. A control point weighs the
+     * BlockFrequencyInfo frequency of its block relative to the entry block, times one plus its loop nesting depth; for
+     * loops the header is used. A feature controls a control point if the condition reads the feature or any variable the
+     * feature's value flows into through stores (in optimized IR, through the named SSA values it is computed into; see
+     * collectValueFlow), so an input copied into a loop bound is credited with that loop. Without BlockFrequencyInfo every block has frequency 1.
+     *
+     * When the function has profile counts, a control point weighs the execution count of its block instead, which
+     * already accounts for the loops around it, so a feature's score is the dynamic work it controls. The counts are
+     * those of -seminal-profile when it has some for F, otherwise those F was compiled with. A feature whose control
+     * points are all cold, or that controls none in a cold function, is marked cold (see -seminal-suppress-cold).
+     * Cold counts are those below -seminal-cold-ratio of the largest count in the profile summary, which is the same
+     * for every module built with one profile; without a summary, only zero counts.
+     */
+
+    void scoreFeatures(Function &F, LoopInfo &LI, const BlockFrequencyInfo *BFI, const SeminalProfileCounts *profile,
+                       const ValueFlowMap &flowsInto, SeminalFeatureInfo &info) {
+        bool applied = profile && profile->hasCounts(F);
+        bool profiled = applied || (BFI && F.hasProfileData());
+        double entryFrequency = BFI ? BFI->getBlockFreq(&F.getEntryBlock()).getFrequency() : 1.0;
+        auto blockCount = [&](const BasicBlock *BB) -> uint64_t {
+            if (applied) {
+                return profile->count(BB);
+            }
+            auto count = BFI->getBlockProfileCount(BB);
+            return count ? *count : 0;
+        };
+        auto weight = [&](const BasicBlock *BB) {
+            if (profiled) {
+                return double(blockCount(BB));
+            }
+            double frequency = BFI && entryFrequency > 0 ? BFI->getBlockFreq(BB).getFrequency() / entryFrequency : 1.0;
+            return frequency * (1 + LI.getLoopDepth(BB));
+        };
+        double coldCount = 1;
+        if (applied) {
+            coldCount = std::max(1.0, ColdRatio * profile->maxCount());
+        } else if (profiled) {
+            if (Metadata *summary = F.getParent()->getProfileSummary(/*IsCS=*/false)) {
+                if (std::unique_ptr<ProfileSummary> parsed{ProfileSummary::getFromMD(summary)}) {
+                    coldCount = std::max(1.0, ColdRatio * parsed->getMaxCount());
+                }
+            }
+        }
+        auto cold = [&](const BasicBlock *BB) { return blockCount(BB) < coldCount; };
+
+        for (SeminalFeature &feature : info.features) {
+            std::set<std::string> reached = {feature.name};
+            std::vector<std::string> worklist = {feature.name};
+            while (!worklist.empty()) {
+                std::string name = worklist.back();
+                worklist.pop_back();
+                auto it = flowsInto.find(name);
+                if (it == flowsInto.end()) {
+                    continue;
+                }
+                for (const std::string &target : it->second) {
+                    if (reached.insert(target).second) {
+                        worklist.push_back(target);
+                    }
+                }
+            }
+
+            // Control points mostly share their variable sets, so each distinct set is checked once.
+            DenseMap<const void *, bool> controlled;
+            auto controls = [&](const SeminalControlPoint &point) {
+                auto inserted = controlled.try_emplace(point.variables.identity(), false);
+                if (inserted.second) {
+                    inserted.first->second =
+                        llvm::any_of(point.variables, [&](const std::string &name) { return reached.count(name) > 0; });
+                }
+                return inserted.first->second;
+            };
+            bool controlsAny = false, controlsHot = false;
+            auto credit = [&](const BasicBlock *BB) {
+                feature.score += weight(BB);
+                controlsAny = true;
+                controlsHot = controlsHot || (profiled && !cold(BB));
+            };
+            for (const SeminalControlPoint &loop : info.loops) {
+                if (controls(loop)) {
+                    credit(loop.loop->getHeader());
+                }
+            }
+            for (const SeminalControlPoint &branch : info.branches) {
+                if (controls(branch)) {
+                    credit(branch.terminator->getParent());
+                }
+            }
+            if (profiled && SuppressCold) {
+                feature.cold = controlsAny ? !controlsHot : cold(&F.getEntryBlock());
+            }
+        }
+    }
+
+    void sortFeatures(std::vector<SeminalFeature> &features) {
+        llvm::sort(features, [](const SeminalFeature &a, const SeminalFeature &b) {
+            return std::tie(a.line, a.name) < std::tie(b.line, b.name);
+        });
+    }
+
+    /**
+     * Function: computeDegradedFeatures
+     *
+     * Description:
+     * Cheap over-approximation of computeSeminalFeatures for functions that exceed their budget. Every declared variable
+     * (every named SSA value in optimized IR) is a feature, and the variables written by input calls are found as
+     * usual, which only takes a scan of the calls, as are the loaded globals the module summary knows input reaches. The def-use walks are replaced by the register-only backward slice of
+     * each loop and branch condition: every variable loaded in the slice is attributed to the condition, and the walk
+     * stops at the load instead of following memory into stores and calls. Scores do not credit value flow through
+     * stores. The cost is linear in the size of the function per control point. Dispatches get the same slice.
+     */
+
+    SeminalFeatureInfo computeDegradedFeatures(Function &F, LoopInfo &LI, const BlockFrequencyInfo *BFI,
+                                               const GlobalInputSummary *globals, const IndirectCallTargets *indirectCalls,
+                                               CallStringSummaries &callSummaries, const SeminalProfileCounts *profile,
+                                               bool ssaVariables) {
+        SeminalFeatureInfo info;
+        WalkContext context(F, nullptr, ssaVariables);
+        VariableMap variableMap;
+        IOVariableMap ioVariables;
+
+        // The context's one pass over every dbg.declare, instead of a findDbgDeclare scan per variable.
+        const DenseMap<const Value *, DbgDeclareInst *> &declarations = context.declarations;
+        if (ssaVariables) {
+            for (Argument &A : F.args()) {
+                recordVariable(&A, F, &context, variableMap);
+            }
+            for (Instruction &I : instructions(F)) {
+                if (!I.getType()->isVoidTy()) {
+                    recordVariable(&I, F, &context, variableMap);
+                }
+            }
+        }
+        for (const auto &entry : declarations) {
+            DbgDeclareInst *DbgDeclare = entry.second;
+            std::string varName = DbgDeclare->getVariable()->getName().str();
+            variableMap[varName] = VariableInfo(varName, DbgDeclare->getDebugLoc().getLine(), DbgDeclare);
+        }
+        if (globals && globals->readsInput(&F)) {
+            for (Instruction &I : instructions(F)) {
+                VariableInfo global;
+                auto *Load = dyn_cast<LoadInst>(&I);
+                if (Load && inputGlobal(Load->getPointerOperand(), globals, global) && !ioVariables.count(global.name)) {
+                    ioVariables[global.name] = globals->lookup(cast<GlobalVariable>(global.value))->sources;
+                    variableMap[global.name] = global;
+                }
+            }
+        }
+
+        for (Instruction &I : instructions(F)) {
+            auto *CI = dyn_cast<CallBase>(&I);
+            Function *calledFunction = CI ? CI->getCalledFunction() : nullptr;
+            if (isInputFunction(calledFunction)) {
+                info.sources.push_back(CI);
+                recordInputCall(CI, &context, variableMap, ioVariables, F);
+            } else if (const FunctionFeatureSummary *summary = CI ? callSummaries.lookup(CI) : nullptr) {
+                if (summary->readsInput) {
+                    info.sources.push_back(CI);
+                }
+                applyCallSummary(CI, *summary, &context, variableMap, ioVariables, F);
+            }
+        }
+
+        for (const auto &entry : variableMap) {
+            const VariableInfo &variable = entry.second;
+            SeminalFeature feature;
+            feature.name = variable.name;
+            feature.line = variable.line < 0 ? 0 : variable.line;
+            feature.declaration = variable.declaration;
+            feature.value = variable.value;
+            auto io = ioVariables.find(variable.name);
+            if (io != ioVariables.end()) {
+                feature.fromInput = true;
+                feature.sources = io->second;
+                // Without the propagation only the calls writing the variable are known to reach it.
+                feature.origins = io->second;
+            }
+            info.features.push_back(std::move(feature));
+        }
+        sortFeatures(info.features);
+
+        auto sliceVariables = [&](ArrayRef<Value *> roots, std::vector<std::string> &variables) {
+            VisitedSet visited;
+            SmallVector<Value *, 32> worklist(roots.begin(), roots.end());
+            while (!worklist.empty()) {
+                Value *V = worklist.pop_back_val();
+                if (!visited.insert(V).second) {
+                    continue;
+                }
+                VariableInfo variable;
+                if (ssaVariables && findSSAVariable(V, variable)) {
+                    variables.push_back(variable.name);
+                }
+                auto *I = dyn_cast<Instruction>(V);
+                if (!I) {
+                    continue;
+                }
+                if (auto *Load = dyn_cast<LoadInst>(I)) {
+                    auto it = declarations.find(Load->getPointerOperand());
+                    VariableInfo global;
+                    if (it != declarations.end()) {
+                        variables.push_back(it->second->getVariable()->getName().str());
+                    } else if (inputGlobal(Load->getPointerOperand(), globals, global)) {
+                        variables.push_back(global.name);
+                    }
+                    // The address itself may be computed from variables, as in a[i].
+                    worklist.push_back(Load->getPointerOperand());
+                    continue;
+                }
+                worklist.append(I->op_begin(), I->op_end());
+            }
+            llvm::sort(variables);
+            variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+        };
+        collectControlPoints(F, LI, sliceVariables, nullptr, info);
+        if (indirectCalls) {
+            collectDispatches(F, *indirectCalls, sliceVariables, nullptr, info);
+        }
+        scoreFeatures(F, LI, BFI, profile, ValueFlowMap(), info);
+        return info;
+    }
+
+    /**
+     * Function: remapFeatureInfo
+     *
+     * Description:
+     * Translates the result computed for 'representative' to 'member', a function FunctionComparator found structurally
+     * identical. Identical functions have the same instruction sequence, so every instruction the result refers to
+     * (dbg.declares, input calls, terminators) is matched to the member's instruction at the same position; the member's
+     * dbg.declares give its own variable names and lines, and its LoopInfo gives the loop with the matching header.
+     */
+
+    SeminalFeatureInfo remapFeatureInfo(const SeminalFeatureInfo &info, Function &representative, Function &member, LoopInfo &memberLI) {
+        DenseMap<const Instruction *, unsigned> positions;
+        unsigned position = 0;
+        for (Instruction &I : instructions(representative)) {
+            positions[&I] = position++;
+        }
+        std::vector<const Instruction *> memberInstructions;
+        memberInstructions.reserve(position);
+        for (Instruction &I : instructions(member)) {
+            memberInstructions.push_back(&I);
+        }
+        auto mapInstruction = [&](const Instruction *I) -> const Instruction * {
+            auto it = I ? positions.find(I) : positions.end();
+            if (it == positions.end() || it->second >= memberInstructions.size()) {
+                return nullptr;
+            }
+            return memberInstructions[it->second];
+        };
+        // Input calls of other functions, which reach globals both read, are kept.
+        auto mapCalls = [&](const std::vector<const CallBase *> &calls) {
+            std::vector<const CallBase *> mapped;
+            for (const CallBase *CI : calls) {
+                if (CI->getFunction() != &representative) {
+                    mapped.push_back(CI);
+                } else if (const auto *memberCall = dyn_cast_or_null<CallBase>(mapInstruction(CI))) {
+                    mapped.push_back(memberCall);
+                }
+            }
+            return mapped;
+        };
+
+        SeminalFeatureInfo remapped;
+        std::unordered_map<std::string, std::string> renamed;
+        for (const SeminalFeature &feature : info.features) {
+            SeminalFeature mapped = feature;
+            if (const auto *DbgDeclare = dyn_cast_or_null<DbgDeclareInst>(mapInstruction(feature.declaration))) {
+                if (DbgDeclare->getVariable()) {
+                    mapped.name = DbgDeclare->getVariable()->getName().str();
+                    mapped.line = DbgDeclare->getDebugLoc().getLine();
+                    mapped.declaration = DbgDeclare;
+                }
+            } else if (feature.value) {
+                // Variables of optimized IR are named through the member's own value at the same position.
+                Value *memberValue = nullptr;
+                if (const auto *A = dyn_cast<Argument>(feature.value)) {
+                    memberValue = member.getArg(A->getArgNo());
+                } else if (const auto *I = dyn_cast<Instruction>(feature.value)) {
+                    memberValue = const_cast<Instruction *>(mapInstruction(I));
+                }
+                VariableInfo variable;
+                if (memberValue && findSSAVariable(memberValue, variable)) {
+                    mapped.name = variable.name;
+                    mapped.line = variable.line < 0 ? 0 : variable.line;
+                    mapped.value = memberValue;
+                }
+            }
+            mapped.sources = mapCalls(feature.sources);
+            mapped.origins = mapCalls(feature.origins);
+            renamed[feature.name] = mapped.name;
+            remapped.features.push_back(std::move(mapped));
+        }
+        sortFeatures(remapped.features);
+
+        // The representative's control points share their sets, and so do the member's: each set is mapped once.
+        SetPool<std::string> namePool;
+        SetPool<const CallBase *> callPool;
+        DenseMap<const void *, InternedSet<std::string>> mappedNames;
+        DenseMap<const void *, InternedSet<const CallBase *>> mappedCalls;
+        auto mapVariables = [&](const InternedSet<std::string> &names) {
+            auto inserted = mappedNames.try_emplace(names.identity());
+            if (inserted.second) {
+                std::vector<std::string> variables;
+                for (const std::string &name : names) {
+                    auto it = renamed.find(name);
+                    variables.push_back(it != renamed.end() ? it->second : name);
+                }
+                llvm::sort(variables);
+                variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+                inserted.first->second = namePool.intern(std::move(variables));
+            }
+            return inserted.first->second;
+        };
+        auto mapSources = [&](const InternedSet<const CallBase *> &sources) {
+            auto inserted = mappedCalls.try_emplace(sources.identity());
+            if (inserted.second) {
+                inserted.first->second = callPool.intern(mapCalls(sources.elements()));
+            }
+            return inserted.first->second;
+        };
+        auto mapControlPoint = [&](const SeminalControlPoint &point) {
+            SeminalControlPoint mapped;
+            mapped.terminator = mapInstruction(point.terminator);
+            if (point.loop) {
+                const Instruction *header = mapInstruction(&point.loop->getHeader()->front());
+                mapped.loop = header ? memberLI.getLoopFor(header->getParent()) : nullptr;
+            }
+            mapped.variables = mapVariables(point.variables);
+            mapped.sources = mapSources(point.sources);
+            return mapped;
+        };
+        for (const SeminalControlPoint &loop : info.loops) {
+            remapped.loops.push_back(mapControlPoint(loop));
+        }
+        for (const SeminalControlPoint &branch : info.branches) {
+            remapped.branches.push_back(mapControlPoint(branch));
+        }
+        // Identical functions call through pointers with the same targets: the pointers come from the same places.
+        for (const SeminalDispatch &dispatch : info.dispatches) {
+            SeminalDispatch mapped = dispatch;
+            mapped.call = dyn_cast_or_null<CallBase>(mapInstruction(dispatch.call));
+            if (!mapped.call) {
+                continue;
+            }
+            mapped.variables = mapVariables(dispatch.variables);
+            mapped.sources = mapSources(dispatch.sources);
+            remapped.dispatches.push_back(std::move(mapped));
+        }
+        remapped.sources = mapCalls(info.sources);
+        remapped.steps = info.steps;
+        remapped.degraded = info.degraded;
+        remapped.degradedReason = info.degradedReason;
+        return remapped;
+    }
+
+    // An input call site in the JSON output: the function called and the line of the call.
+    Json inputCallJson(const CallBase *CI) {
+        Json callJson;
+        const Function *callee = CI->getCalledFunction();
+        callJson["callee"] = callee ? callee->getName().str() : std::string();
+        callJson["line"] = CI->getDebugLoc() ? CI->getDebugLoc().getLine() : 0;
+        return callJson;
+    }
+
+}  // end of anonymous namespace
+
+/**
+ * Function: computeSeminalFeatures
+ * 
+ * Description:
+ * This function analyzes a given LLVM function to identify seminal input features that influence key execution points, particularly loop termination conditions. It operates in several steps:
+ * 1. Identifying and analyzing all loops in the function to trace variables influencing their termination.
+ * 2. Tracing the source of all variables within the function using def-use chains to understand their origins and interactions.
+ * 3. Searching for variables related to input operations, particularly focusing on standard IO functions and handling special cases like 'fopen'.
+ * 4. Matching variables that influence loop terminations with those affected by input operations, to pinpoint seminal input features.
+ * 
+ * At -O0, variables are allocas described by dbg.declare. Functions without any dbg.declare (-O1/-O2 builds, see -seminal-optimized-ir) are analyzed
+ * in SSA form instead: the walks pass through PHI nodes and name every value they reach with findSSAVariable, and step 2 lists every named value.
+ * 
+ * Every step of the walks is charged to an AnalysisBudget. When a step, memory or time limit is hit, the partial result is dropped and the
+ * function gets computeDegradedFeatures instead, flagged with the reason, so one pathological function cannot stall the whole run.
+ * 
+ * Steps 1-3 are performed here, together with the per-loop and per-branch condition variables and the feature scores. Step 4 is a query on the result
+ * (SeminalFeatureInfo::reportedFeatures); reportSeminalFeatures prints it and appends a JSON-formatted summary of influential variables,
+ * classified as either direct IO variables or potential influencers, to the caller's JSON array.
+ * 
+ * Inputs:
+ * Function &F - A reference to the LLVM Function to be analyzed.
+ * LoopInfo &LI - Loop information for the current function, used to identify and analyze loops.
+ * const BlockFrequencyInfo *BFI - Optional static block frequencies, used to score the features by the hotness of the loops and branches they control.
+ *   When F has profile counts, they are the counts of its blocks instead.
+ * AAResults *AA - Optional alias analysis; the def-use walks then follow memory only into writers that may modify what is read (see -seminal-use-aa).
+ * const FeatureSummaryIndex *summaries - Optional combined summary index; calls to functions it covers are treated as input sources or loop-bound sinks according to their summary.
+ *   Calls to functions defined in the module are treated the same way, with summaries computed under k-limited call strings (see CallStringSummaries).
+ * const GlobalInputSummary *globals - Optional module summary of the globals written with input; a global read by the function's conditions or stores
+ *   is then a feature written by the input calls of every function that stores input into it.
+ * const IndirectCallTargets *indirectCalls - Optional targets of the module's calls through function pointers; such calls then get the summaries of
+ *   their targets, and those with several targets are recorded as dispatches, flagged when input selects the target (see collectDispatches).
+ * CallStringSummaries *callSummaries - Optional call string summaries shared by the module (see CallStringAnalysis); without them, the summaries
+ *   of the calls of F are computed for F alone and dropped with its result.
+ * const SeminalProfileCounts *profile - Optional block counts of -seminal-profile; when it has counts for F, they score the features instead of BFI.
+ * 
+ * Outputs:
+ * The variables found along the def-use chains, marked with the input calls that write them and scored, and the function's control points.
+ */
+
+SeminalFeatureInfo llvm::computeSeminalFeatures(Function &F, LoopInfo &LI, const BlockFrequencyInfo *BFI, AAResults *AA, const FeatureSummaryIndex *summaries,
+                                                const GlobalInputSummary *globals, const IndirectCallTargets *indirectCalls,
+                                                CallStringSummaries *callSummaries, const SeminalProfileCounts *profile) {
+    std::optional<CallStringSummaries> ownSummaries;
+    if (!callSummaries) {
+        callSummaries = &ownSummaries.emplace(ContextDepth, ContextLimit, summaries, indirectCalls);
+    }
+    // Installed before the walk containers are created, and removed after they are destroyed.
+    MemoryAccount account;
+    MemoryAccount *outerAccount = currentMemoryAccount;
+    if (MemoryReport) {
+        currentMemoryAccount = &account;
+    }
+    auto restoreAccount = make_scope_exit([&] { currentMemoryAccount = outerAccount; });
+    auto recordMemory = [&](SeminalFeatureInfo &result) {
+        result.memory.visitedSets = account.peak[VisitedSets];
+        result.memory.variableMaps = account.peak[VariableMaps];
+        result.memory.total = account.peakTotal;
+    };
+
+    SeminalFeatureInfo info;
+    VisitedSet visited;
+    VariableMap variableMap;
+    IOVariableMap ioVariables;
+    AnalysisBudget budget;
+    WalkContext walkContext(F, UseAliasAnalysis ? AA : nullptr, usesSSAVariables(F));
+    walkContext.budget = &budget;
+    walkContext.globals = globals;
+    const WalkContext *context = &walkContext;
+    auto degrade = [&] {
+        SeminalFeatureInfo degraded = computeDegradedFeatures(F, LI, BFI, globals, indirectCalls, *callSummaries, profile,
+                                                              context->ssaVariables);
+        degraded.steps = budget.steps;
+        degraded.degraded = true;
+        degraded.degradedReason = budget.reason();
+        recordMemory(degraded);
+        return degraded;
+    };
+    if (budget.exhausted()) {
+        return degrade();
+    }
+    //step1: Find all loops.
+    for (Loop *loop : LI) {
+        analyzeLoop(loop, visited, variableMap, F, context);
+    }
+    
+    //step2: Trace the source of all variables within the function.
+    if (context->ssaVariables) {
+        for (Argument &A : F.args()) {
+            recordVariable(&A, F, context, variableMap);
+        }
+    }
+    for (auto &BB : F) {
+        if (!budget.checkDeadline()) {
+            return degrade();
+        }
+        for (auto &I : BB) {
+            if (context->ssaVariables) {
+                if (!I.getType()->isVoidTy()) {
+                    recordVariable(&I, F, context, variableMap);
+                }
+            } else if (AllocaInst *AI = dyn_cast<AllocaInst>(&I)) {
+                DbgDeclareInst *DbgDeclare = context->declarationOf(AI);
+                if (DbgDeclare && DbgDeclare->getVariable()) {
+                    std::string varName = DbgDeclare->getVariable()->getName().str();
+                    int lineNo = DbgDeclare->getDebugLoc().getLine();
+                   // OS << "Variable " << varName << " allocated at line " << lineNo << "\n";
+                    variableMap[varName] = VariableInfo(varName, lineNo, DbgDeclare);
+                }
+            }
+            if (StoreInst *SI = dyn_cast<StoreInst>(&I)) {
+                Value *storedValue = SI->getValueOperand();
+                Value *storedLocation = SI->getPointerOperand();
+                trackDefUseChain(storedValue, visited, variableMap, F, context);
+                if (!context->AA) {
+                    trackDefUseChain(storedLocation, visited, variableMap, F, context);
+                }
+            }
+        }
+    }
+    if (budget.exhausted()) {
+        return degrade();
+    }
+  
+    //step3: Search for input-related variables.
+    SmallPtrSet<const Value *, 8> sizedContainers;
+    for (auto &BB : F) {
+        for (auto &I : BB) {
+            if (CallBase *CI = dyn_cast<CallBase>(&I)) {
+                Function *calledFunction = CI->getCalledFunction();
+                if (CI->arg_size() > 0 && classifyFunction(calledFunction).containerSize) {
+                    sizedContainers.insert(CI->getArgOperand(0)->stripPointerCasts());
+                }
+               // OS <<calledFunction->getName().str()<<'\n';
+                if (isInputFunction(calledFunction)) {
+                    //OS << "Find IO Function "<<calledFunction->getName().str()<<"\n";
+                    info.sources.push_back(CI);
+                    recordInputCall(CI, context, variableMap, ioVariables, F);
+                } else if (const FunctionFeatureSummary *summary = callSummaries->lookup(CI)) {
+                    if (summary->readsInput) {
+                        info.sources.push_back(CI);
+                    }
+                    applyCallSummary(CI, *summary, context, variableMap, ioVariables, F);
+                }
+            }
+        }
+    }
+
+    // Globals the walks reached are written by the input calls the module summary found for them, wherever those are.
+    if (globals) {
+        for (const auto &entry : variableMap) {
+            const auto *GV = dyn_cast_or_null<GlobalVariable>(entry.second.value);
+            if (const GlobalInputInfo *global = GV ? globals->lookup(GV) : nullptr) {
+                std::vector<const CallBase *> &writers = ioVariables[entry.first];
+                writers.insert(writers.end(), global->sources.begin(), global->sources.end());
+            }
+        }
+    }
+
+    // Which input calls reach each variable and condition, for all of them at once.
+    std::optional<InputTaint> taint;
+    if (InputAttribution) {
+        taint.emplace(F, info.sources, *callSummaries, globals, &budget);
+        if (budget.exhausted()) {
+            return degrade();
+        }
+    }
+    auto variableTaint = [&](const VariableInfo &variable) {
+        const BitVector *inputs = taint->emptySet();
+        if (variable.declaration && variable.declaration->getAddress()) {
+            inputs = taint->memoryTaint(variable.declaration->getAddress());
+        } else if (variable.value) {
+            inputs = taint->valueTaint(variable.value);
+            if (isa<AllocaInst>(variable.value) || isa<GlobalVariable>(variable.value)) {
+                inputs = taint->unite(inputs, taint->memoryTaint(variable.value));
+            }
+        }
+        return inputs;
+    };
+
+    for (const auto &entry : variableMap) {
+        const VariableInfo &variable = entry.second;
+        SeminalFeature feature;
+        feature.name = variable.name;
+        feature.line = variable.line < 0 ? 0 : variable.line;
+        feature.declaration = variable.declaration;
+        feature.value = variable.value;
+        auto io = ioVariables.find(variable.name);
+        if (io != ioVariables.end()) {
+            feature.fromInput = true;
+            feature.sources = io->second;
+        }
+        if (taint) {
+            feature.origins = taint->calls(variableTaint(variable)).elements();
+            // A std::string or std::vector that input is appended to is read through its size like a scanf'd count.
+            const Value *storage = variable.declaration ? variable.declaration->getAddress() : variable.value;
+            if (!feature.fromInput && !feature.origins.empty() && sizedContainers.count(storage)) {
+                feature.fromInput = true;
+                feature.sources = feature.origins;
+            }
+        } else {
+            feature.origins = feature.sources;
+        }
+        info.features.push_back(std::move(feature));
+    }
+    sortFeatures(info.features);
+    auto conditionVariables = [&](ArrayRef<Value *> roots, std::vector<std::string> &variables) {
+        collectConditionVariables(roots, F, context, variables);
+    };
+    collectControlPoints(F, LI, conditionVariables, taint ? &*taint : nullptr, info);
+    if (indirectCalls) {
+        collectDispatches(F, *indirectCalls, conditionVariables, taint ? &*taint : nullptr, info);
+    }
+    ValueFlowMap flowsInto = collectValueFlow(F, context);
+    if (!budget.checkDeadline()) {
+        return degrade();
+    }
+    scoreFeatures(F, LI, BFI, profile, flowsInto, info);
+    info.steps = budget.steps;
+    recordMemory(info);
+    return info;
+}
+
+const SeminalFeature *SeminalFeatureInfo::lookup(StringRef name) const {
+    for (const SeminalFeature &feature : features) {
+        if (feature.name == name) {
+            return &feature;
+        }
+    }
+    return nullptr;
+}
+
+bool SeminalFeatureInfo::hasInputFeatures() const {
+    return llvm::any_of(features, [](const SeminalFeature &feature) { return feature.fromInput; });
+}
+
+std::vector<const SeminalFeature *> SeminalFeatureInfo::reportedFeatures() const {
+    //step4: Match the termination condition variable with the input-related variable.
+    bool inputOnly = hasInputFeatures();
+    std::vector<const SeminalFeature *> reported;
+    for (const SeminalFeature &feature : features) {
+        if ((!inputOnly || feature.fromInput) && !feature.cold) {
+            reported.push_back(&feature);
+        }
+    }
+    // Hottest first; features is sorted by line, which breaks ties.
+    std::stable_sort(reported.begin(), reported.end(),
+                     [](const SeminalFeature *a, const SeminalFeature *b) { return a->score > b->score; });
+    if (FunctionTopK > 0 && reported.size() > FunctionTopK) {
+        reported.resize(FunctionTopK);
+    }
+    return reported;
+}
+
+size_t SeminalFeatureInfo::coldFeatures() const {
+    bool inputOnly = hasInputFeatures();
+    return llvm::count_if(features, [&](const SeminalFeature &feature) { return (!inputOnly || feature.fromInput) && feature.cold; });
+}
+
+std::vector<const SeminalDispatch *> SeminalFeatureInfo::inputDispatches() const {
+    std::vector<const SeminalDispatch *> selected;
+    for (const SeminalDispatch &dispatch : dispatches) {
+        if (dispatch.inputSelected) {
+            selected.push_back(&dispatch);
+        }
+    }
+    return selected;
+}
+
+std::vector<bool> llvm::selectModuleTopFeatures(ArrayRef<double> scores) {
+    std::vector<bool> keep(scores.size(), true);
+    if (ModuleTopK == 0 || scores.size() <= ModuleTopK) {
+        return keep;
+    }
+    std::vector<double> sorted(scores.begin(), scores.end());
+    std::nth_element(sorted.begin(), sorted.begin() + (ModuleTopK - 1), sorted.end(), std::greater<double>());
+    double cutoff = sorted[ModuleTopK - 1];
+    // Features scoring exactly the cutoff are kept in module order until the limit is reached.
+    unsigned remaining = ModuleTopK - llvm::count_if(scores, [&](double score) { return score > cutoff; });
+    for (size_t i = 0; i < scores.size(); ++i) {
+        if (scores[i] < cutoff) {
+            keep[i] = false;
+        } else if (scores[i] == cutoff) {
+            if (remaining == 0) {
+                keep[i] = false;
+            } else {
+                --remaining;
+            }
+        }
+    }
+    return keep;
+}
+
+bool SeminalFeatureInfo::invalidate(Function &F, const PreservedAnalyses &PA, FunctionAnalysisManager::Invalidator &Inv) {
+    auto PAC = PA.getChecker<SeminalFeatureAnalysis>();
+    return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>()) || Inv.invalidate<LoopAnalysis>(F, PA);
+}
+
+AnalysisKey SeminalFeatureAnalysis::Key;
+
+SeminalFeatureInfo SeminalFeatureAnalysis::run(Function &F, FunctionAnalysisManager &FAM) {
+    // Only a cached module result can be used from a function analysis; drivers compute it first. The function
+    // result goes when the module results it was computed with are invalidated.
+    const GlobalInputSummary *globals = nullptr;
+    const IndirectCallTargets *indirectCalls = nullptr;
+    CallStringSummaries *callSummaries = nullptr;
+    const SeminalProfileCounts *profile = nullptr;
+    if (moduleAnalyses) {
+        auto &moduleProxy = FAM.getResult<ModuleAnalysisManagerFunctionProxy>(F);
+        globals = moduleAnalyses->getCachedResult<GlobalInputAnalysis>(*F.getParent());
+        if (globals) {
+            moduleProxy.registerOuterAnalysisInvalidation<GlobalInputAnalysis, SeminalFeatureAnalysis>();
+        }
+        indirectCalls = moduleAnalyses->getCachedResult<IndirectCallAnalysis>(*F.getParent());
+        if (indirectCalls) {
+            moduleProxy.registerOuterAnalysisInvalidation<IndirectCallAnalysis, SeminalFeatureAnalysis>();
+        }
+        callSummaries = moduleAnalyses->getCachedResult<CallStringAnalysis>(*F.getParent());
+        if (callSummaries) {
+            moduleProxy.registerOuterAnalysisInvalidation<CallStringAnalysis, SeminalFeatureAnalysis>();
+        }
+        profile = moduleAnalyses->getCachedResult<SeminalProfileAnalysis>(*F.getParent());
+        if (profile) {
+            moduleProxy.registerOuterAnalysisInvalidation<SeminalProfileAnalysis, SeminalFeatureAnalysis>();
+        }
+    }
+    return computeSeminalFeatures(F, FAM.getResult<LoopAnalysis>(F), &FAM.getResult<BlockFrequencyAnalysis>(F),
+                                  &FAM.getResult<AAManager>(F), summaries, globals, indirectCalls, callSummaries, profile);
+}
+
+AnalysisKey CallStringAnalysis::Key;
+
+CallStringSummaries CallStringAnalysis::run(Module &M, ModuleAnalysisManager &MAM) {
+    return CallStringSummaries(ContextDepth, ContextLimit, summaries, &MAM.getResult<IndirectCallAnalysis>(M));
+}
+
+// The -seminal-profile file is checked once, so that an unreadable profile is reported once and ignored, rather than
+// raised as an error diagnostic by PGOInstrumentationUse for every module.
+static bool profileReadable() {
+    static const bool readable = [] {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(ProfileFile);
+        if (!buffer) {
+            errs() << "Cannot read the profile " << ProfileFile << ": " << buffer.getError().message() << "\n";
+            return false;
+        }
+        if (!IndexedInstrProfReader::hasFormat(**buffer)) {
+            errs() << ProfileFile << " is not an indexed instrumentation profile (llvm-profdata merge writes one)\n";
+            return false;
+        }
+        return true;
+    }();
+    return readable;
+}
+
+bool SeminalProfileCounts::invalidate(Module &, const PreservedAnalyses &PA, ModuleAnalysisManager::Invalidator &) {
+    auto PAC = PA.getChecker<SeminalProfileAnalysis>();
+    return !(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Module>>());
+}
+
+AnalysisKey SeminalProfileAnalysis::Key;
+
+/**
+ * Function: SeminalProfileAnalysis::run
+ *
+ * Description:
+ * Clones M and runs PGOInstrumentationUse on the copy, with analysis managers of its own, so that the branch weights,
+ * entry counts and profile summary it attaches never reach M. The block counts BlockFrequencyInfo then derives for
+ * each profiled copy are stored for the original blocks, found through the clone's value map.
+ */
+
+SeminalProfileCounts SeminalProfileAnalysis::run(Module &M, ModuleAnalysisManager &) {
+    SeminalProfileCounts counts;
+    if (ProfileFile.empty() || !profileReadable()) {
+        return counts;
+    }
+    ValueToValueMapTy VMap;
+    std::unique_ptr<Module> copy = CloneModule(M, VMap);
+    // Declared after the copy, so that their results are cleared before it is destroyed.
+    SeminalAnalysisManagers analyses;
+    // Functions whose control flow no longer matches the profile are left without counts, with a warning.
+    analyses.MAM.invalidate(*copy, PGOInstrumentationUse(ProfileFile).run(*copy, analyses.MAM));
+
+    if (Metadata *summary = copy->getProfileSummary(/*IsCS=*/false)) {
+        if (std::unique_ptr<ProfileSummary> parsed{ProfileSummary::getFromMD(summary)}) {
+            counts.largest = parsed->getMaxCount();
+        }
+    }
+    for (Function &F : M) {
+        auto *profiled = F.isDeclaration() ? nullptr : cast<Function>(VMap[&F]);
+        if (!profiled || !profiled->hasProfileData()) {
+            continue;
+        }
+        counts.functions.insert(&F);
+        BlockFrequencyInfo &BFI = analyses.FAM.getResult<BlockFrequencyAnalysis>(*profiled);
+        for (BasicBlock &BB : F) {
+            if (auto count = BFI.getBlockProfileCount(cast<BasicBlock>(VMap[&BB]))) {
+                counts.blocks[&BB] = *count;
+            }
+        }
+    }
+    return counts;
+}
+
+void llvm::registerSeminalModuleAnalyses(ModuleAnalysisManager &MAM, const FeatureSummaryIndex *summaries) {
+    MAM.registerPass([] { return GlobalInputAnalysis(); });
+    MAM.registerPass([] { return IndirectCallAnalysis(); });
+    MAM.registerPass([summaries] { return CallStringAnalysis(summaries); });
+    MAM.registerPass([] { return SeminalProfileAnalysis(); });
+}
+
+void llvm::computeSeminalModuleAnalyses(Module &M, ModuleAnalysisManager &MAM) {
+    MAM.getResult<SeminalProfileAnalysis>(M);
+    MAM.getResult<GlobalInputAnalysis>(M);
+    MAM.getResult<CallStringAnalysis>(M);
+}
+
+SeminalAnalysisManagers::SeminalAnalysisManagers(const FeatureSummaryIndex *summaries) {
+    FAM.registerPass([summaries, this] { return SeminalFeatureAnalysis(summaries, &MAM); });
+    registerSeminalModuleAnalyses(MAM, summaries);
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+}
+
+void llvm::shareSeminalWalkThreads(unsigned threads) {
+    if (threads > 0 && !sharedWalkPool) {
+        sharedWalkPool = std::make_unique<WalkThreadPool>(hardware_concurrency(threads));
+        sharedWalkThreads = threads;
+    }
+}
+
+// Step 4 of the analysis: prints the reported features of F and appends its JSON entry to moduleJson.
+void llvm::reportSeminalFeatures(const Function &F, ArrayRef<const SeminalFeature *> reported, Json &moduleJson, raw_ostream &OS, StringRef degradedReason,
+                                 ArrayRef<const SeminalDispatch *> dispatches) {
+    bool ioVariableFound = llvm::any_of(reported, [](const SeminalFeature *feature) { return feature->fromInput; });
+    if (!degradedReason.empty()) {
+        OS << "Analysis of " << F.getName() << " degraded (" << degradedReason << "), features over-approximated\n";
+    }
+    if (!reported.empty()) {
+        OS << "Seminal Input Feature: ";
+        for (const SeminalFeature *feature : reported) {
+            if (ioVariableFound) {
+                OS << "Key variable: " << feature->name << ", Line: " << feature->line << "\n";
+            } else {
+                // If no IO variables were found, output all variables that could potentially influence loop termination
+                OS << "Potential influential variable: " << feature->name << ", Line: " << feature->line << "\n";
+            }
+        }
+        OS << "\n";
+    } else {
+        OS << "No influential variables affected by external input detected.\n";
+    }
+
+    Json dispatchesJson = Json::array();
+    for (const SeminalDispatch *dispatch : dispatches) {
+        unsigned line = dispatch->call->getDebugLoc() ? dispatch->call->getDebugLoc().getLine() : 0;
+        Json targets = Json::array();
+        OS << "Input-selected dispatch: Line: " << line << ", Targets: ";
+        for (const Function *target : dispatch->targets) {
+            OS << (targets.empty() ? "" : ", ") << target->getName();
+            targets.push_back(target->getName().str());
+        }
+        OS << "\n";
+        Json dispatchJson;
+        dispatchJson["line"] = line;
+        dispatchJson["targets"] = std::move(targets);
+        dispatchJson["variables"] = dispatch->variables.elements();
+        if (!dispatch->sources.empty()) {
+            Json origins = Json::array();
+            for (const CallBase *origin : dispatch->sources) {
+                origins.push_back(inputCallJson(origin));
+            }
+            dispatchJson["origins"] = std::move(origins);
+        }
+        dispatchesJson.push_back(std::move(dispatchJson));
+    }
+
+    Json variablesJson = Json::array();
+    for (const SeminalFeature *feature : reported) {
+        Json variableJson;
+        variableJson["name"] = feature->name;
+        variableJson["line"] = feature->line;
+        variableJson["type"] = ioVariableFound ? "IO" : "Potential";
+        variableJson["score"] = feature->score;
+        if (!feature->origins.empty()) {
+            Json origins = Json::array();
+            for (const CallBase *origin : feature->origins) {
+                origins.push_back(inputCallJson(origin));
+            }
+            variableJson["origins"] = std::move(origins);
+        }
+        variablesJson.push_back(variableJson);
+    }
+    if (!variablesJson.empty() || !dispatchesJson.empty()) {
+        Json functionJson;
+        functionJson["function"] = F.getName().str();
+        functionJson["influential_variables"] = variablesJson;
+        if (!dispatchesJson.empty()) {
+            functionJson["input_dispatch"] = std::move(dispatchesJson);
+        }
+        if (!degradedReason.empty()) {
+            functionJson["degraded"] = degradedReason.str();
+        }
+        moduleJson.push_back(functionJson);
+    }
+}
+
+/**
+ * Function: visitModuleSeminalFeatures
+ *
+ * Description:
+ * Hands the result of every function defined in M to 'consume', analyzing each structurally distinct function body only once.
+ * Functions are bucketed by FunctionComparator::functionHash and confirmed identical with FunctionComparator, which
+ * ignores names and debug metadata; template instantiations and macro-generated copies therefore share one
+ * representative, whose cached SeminalFeatureAnalysis result is remapped to each member's variable names and lines.
+ * Module time scales with the number of distinct shapes rather than the number of copies. Functions with profile counts
+ * are analyzed on their own, since copies of one body run different numbers of times.
+ *
+ * The steps and estimated result memory of every function analyzed here are charged to the module budgets, which the analyses
+ * read through this thread's ModuleBudget; once one is spent, the remaining functions get the degraded result. Functions
+ * 'skip' leaves out are not charged, and are not representatives for the copies after them.
+ */
+
+void llvm::visitModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM, function_ref<void(const Function &, const SeminalFeatureInfo &)> consume,
+                                      function_ref<bool(const Function &)> skip) {
+    std::unordered_map<FunctionComparator::FunctionHash, std::vector<Function *>> shapes;
+    GlobalNumberState globalNumbers;
+    ModuleBudget moduleBudget;
+    ModuleBudget *outerBudget = currentModuleBudget;
+    currentModuleBudget = &moduleBudget;
+    auto restoreBudget = make_scope_exit([&] { currentModuleBudget = outerBudget; });
+    auto analyze = [&](Function &F) -> const SeminalFeatureInfo & {
+        const SeminalFeatureInfo &info = FAM.getResult<SeminalFeatureAnalysis>(F);
+        moduleBudget.steps += info.steps;
+        moduleBudget.bytes += estimatedResultBytes(info);
+        return info;
+    };
+
+    for (Function &F : M) {
+        if (F.isDeclaration() || (skip && skip(F))) {
+            continue;
+        }
+        if (!DeduplicateFunctions || F.hasProfileData() || !ProfileFile.empty()) {
+            consume(F, analyze(F));
+            continue;
+        }
+
+        std::vector<Function *> &candidates = shapes[FunctionComparator::functionHash(F)];
+        Function *representative = nullptr;
+        for (Function *candidate : candidates) {
+            if (FunctionComparator(&F, candidate, &globalNumbers).compare() == 0) {
+                representative = candidate;
+                break;
+            }
+        }
+        if (representative) {
+            const SeminalFeatureInfo &info = FAM.getResult<SeminalFeatureAnalysis>(*representative);
+            consume(F, remapFeatureInfo(info, *representative, F, FAM.getResult<LoopAnalysis>(F)));
+        } else {
+            candidates.push_back(&F);
+            consume(F, analyze(F));
+        }
+    }
+}
+
+// Reports every function of M after applying -seminal-module-top-k across all of them. Functions whose features were
+// all cut by the module limit, or are all cold, are left out.
+//
+// With -seminal-memory-report, the module high-water mark is the largest of, for each function in turn, the results kept for
+// the functions before it plus the function's own walk peak and result, and, at the end, all results plus the JSON entries
+// written for the module. Functions are analyzed one at a time, so their walks are never live together.
+void llvm::analyzeModuleSeminalFeatures(Module &M, FunctionAnalysisManager &FAM, Json &moduleJson, raw_ostream &OS, Json *memoryReport) {
+    struct FunctionFeatures {
+        const Function *function;
+        std::vector<SeminalFeature> reported;
+        std::string degradedReason;
+        std::vector<SeminalDispatch> dispatches;   // the input-selected ones
+        bool cold;                                 // every feature that would be reported is cold
+    };
+    std::vector<FunctionFeatures> functions;
+    std::vector<double> scores;
+    size_t coldFeatures = 0;
+    Json functionsMemory = Json::array();
+    uint64_t retainedBytes = 0;
+    uint64_t highWaterMark = 0;
+    visitModuleSeminalFeatures(M, FAM, [&](const Function &F, const SeminalFeatureInfo &info) {
+        if (MemoryReport) {
+            uint64_t resultBytes = estimatedResultBytes(info);
+            Json functionMemory;
+            functionMemory["function"] = F.getName().str();
+            functionMemory["visited_sets"] = info.memory.visitedSets;
+            functionMemory["variable_maps"] = info.memory.variableMaps;
+            functionMemory["results"] = resultBytes;
+            functionMemory["peak"] = info.memory.total + resultBytes;
+            functionsMemory.push_back(std::move(functionMemory));
+            highWaterMark = std::max(highWaterMark, retainedBytes + info.memory.total + resultBytes);
+            retainedBytes += resultBytes;
+        }
+        std::vector<SeminalFeature> reported;
+        for (const SeminalFeature *feature : info.reportedFeatures()) {
+            reported.push_back(*feature);
+            scores.push_back(feature->score);
+        }
+        std::vector<SeminalDispatch> dispatches;
+        for (const SeminalDispatch *dispatch : info.inputDispatches()) {
+            dispatches.push_back(*dispatch);
+        }
+        size_t cold = info.coldFeatures();
+        coldFeatures += cold;
+        bool allCold = cold > 0 && reported.empty();
+        functions.push_back({&F, std::move(reported), info.degraded ? info.degradedReason : std::string(), std::move(dispatches),
+                             allCold});
+    });
+
+    std::vector<bool> keep = selectModuleTopFeatures(scores);
+    size_t index = 0;
+    size_t firstEntry = moduleJson.size();
+    for (const FunctionFeatures &entry : functions) {
+        std::vector<const SeminalFeature *> kept;
+        for (const SeminalFeature &feature : entry.reported) {
+            if (keep[index++]) {
+                kept.push_back(&feature);
+            }
+        }
+        if ((kept.empty() && !entry.reported.empty()) || (entry.cold && entry.dispatches.empty())) {
+            continue;
+        }
+        std::vector<const SeminalDispatch *> dispatches;
+        for (const SeminalDispatch &dispatch : entry.dispatches) {
+            dispatches.push_back(&dispatch);
+        }
+        reportSeminalFeatures(*entry.function, kept, moduleJson, OS, entry.degradedReason, dispatches);
+    }
+    size_t dropped = llvm::count(keep, false);
+    if (dropped > 0) {
+        OS << dropped << " lower-scoring features not reported (-seminal-module-top-k=" << ModuleTopK << ")\n";
+    }
+    if (coldFeatures > 0) {
+        OS << coldFeatures << " features controlling only cold code not reported (-seminal-suppress-cold)\n";
+    }
+
+    if (MemoryReport) {
+        uint64_t jsonBytes = 0;
+        for (size_t i = firstEntry; i < moduleJson.size(); ++i) {
+            jsonBytes += estimatedJsonBytes(moduleJson[i]);
+        }
+        highWaterMark = std::max(highWaterMark, retainedBytes + jsonBytes);
+        OS << "Analysis memory high-water mark: " << highWaterMark << " bytes\n";
+        if (memoryReport) {
+            (*memoryReport)["high_water_mark"] = highWaterMark;
+            (*memoryReport)["results"] = retainedBytes;
+            (*memoryReport)["json"] = jsonBytes;
+            (*memoryReport)["functions"] = std::move(functionsMemory);
+        }
+    }
+}
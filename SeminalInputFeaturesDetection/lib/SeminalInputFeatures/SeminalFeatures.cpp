@@ -0,0 +1,132 @@
+#include "SeminalInputFeatures/SeminalFeatures.h"
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+using namespace llvm;
+
+namespace {
+
+    unsigned lineOf(const Instruction *I) {
+        return I && I->getDebugLoc() ? I->getDebugLoc().getLine() : 0;
+    }
+
+    SeminalInputCallReport inputCallReport(const CallBase *CI) {
+        const Function *callee = CI->getCalledFunction();
+        return {callee ? callee->getName().str() : std::string(), lineOf(CI)};
+    }
+
+    SeminalControlPointReport controlPointReport(const SeminalControlPoint &point) {
+        SeminalControlPointReport report;
+        report.line = lineOf(point.terminator);
+        if (point.loop) {
+            report.loopDepth = point.loop->getLoopDepth();
+            if (DebugLoc start = point.loop->getStartLoc()) {
+                report.line = start.getLine();
+            }
+        }
+        report.variables = point.variables.elements();
+        for (const CallBase *source : point.sources) {
+            report.inputs.push_back(inputCallReport(source));
+        }
+        return report;
+    }
+
+}  // end of anonymous namespace
+
+/**
+ * Function: reportFunction
+ *
+ * Description:
+ * Copies the result of SeminalFeatureAnalysis for F into a SeminalFunctionReport, replacing every reference to the IR
+ * with names and source lines. The variables are the ones reportSeminalFeatures prints.
+ */
+
+SeminalFunctionReport llvm::reportFunction(const Function &F, const SeminalFeatureInfo &info) {
+    SeminalFunctionReport report;
+    report.function = F.getName().str();
+    for (const SeminalFeature *feature : info.reportedFeatures()) {
+        SeminalVariableReport variable;
+        variable.name = feature->name;
+        variable.line = feature->line;
+        variable.kind = feature->fromInput ? SeminalFeatureKind::IO : SeminalFeatureKind::Potential;
+        variable.score = feature->score;
+        for (const CallBase *source : feature->sources) {
+            variable.inputLines.push_back(lineOf(source));
+        }
+        for (const CallBase *origin : feature->origins) {
+            variable.origins.push_back(inputCallReport(origin));
+        }
+        report.variables.push_back(std::move(variable));
+    }
+    for (const SeminalControlPoint &loop : info.loops) {
+        report.loops.push_back(controlPointReport(loop));
+    }
+    for (const SeminalControlPoint &branch : info.branches) {
+        report.branches.push_back(controlPointReport(branch));
+    }
+    for (const CallBase *source : info.sources) {
+        report.inputCalls.push_back(inputCallReport(source));
+    }
+    for (const SeminalDispatch *dispatch : info.inputDispatches()) {
+        SeminalDispatchReport dispatchReport;
+        dispatchReport.line = lineOf(dispatch->call);
+        for (const Function *target : dispatch->targets) {
+            dispatchReport.targets.push_back(target->getName().str());
+        }
+        dispatchReport.variables = dispatch->variables.elements();
+        for (const CallBase *source : dispatch->sources) {
+            dispatchReport.inputs.push_back(inputCallReport(source));
+        }
+        report.dispatches.push_back(std::move(dispatchReport));
+    }
+    report.degraded = info.degraded;
+    report.degradedReason = info.degradedReason;
+    return report;
+}
+
+SeminalModuleReport llvm::analyzeModule(Module &M, const FeatureSummaryIndex *summaries) {
+    SeminalAnalysisManagers analyses(summaries);
+    analyses.prepare(M);
+    SeminalModuleReport report;
+    std::vector<double> scores;
+    visitModuleSeminalFeatures(M, analyses.FAM, [&](const Function &F, const SeminalFeatureInfo &info) {
+        report.functions.push_back(reportFunction(F, info));
+        for (const SeminalVariableReport &variable : report.functions.back().variables) {
+            scores.push_back(variable.score);
+        }
+    });
+
+    std::vector<bool> keep = selectModuleTopFeatures(scores);
+    size_t index = 0;
+    for (SeminalFunctionReport &function : report.functions) {
+        std::vector<SeminalVariableReport> kept;
+        for (SeminalVariableReport &variable : function.variables) {
+            if (keep[index++]) {
+                kept.push_back(std::move(variable));
+            }
+        }
+        function.variables = std::move(kept);
+    }
+    return report;
+}
+
+Expected<SeminalModuleReport> llvm::analyzeBitcode(MemoryBufferRef buffer, const FeatureSummaryIndex *summaries) {
+    LLVMContext context;
+    SMDiagnostic err;
+    std::unique_ptr<Module> M = parseIR(buffer, err, context);
+    if (!M) {
+        std::string message;
+        raw_string_ostream OS(message);
+        err.print(buffer.getBufferIdentifier().str().c_str(), OS);
+        return createStringError(inconvertibleErrorCode(), OS.str());
+    }
+    return analyzeModule(*M, summaries);
+}
@@ -0,0 +1,244 @@
+#include "SeminalInputFeatures/SharedResultLog.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+using namespace llvm;
+
+namespace {
+
+// Layout of the log file: a fixed header, then records packed back to back in
+// the order their space was reserved. The tail counts reserved bytes after the
+// header; it can run past the end of the file once the log is full.
+struct LogHeader {
+    uint64_t magic;
+    std::atomic<uint64_t> tail;
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t size;                   // payload bytes
+    std::atomic<uint32_t> committed; // set once the payload is complete
+    uint32_t padding;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "the shared log needs address-free atomics");
+
+constexpr uint64_t LogMagic = 0x31474f4c4d4553ULL;   // "SEMLOG1"
+// Starts with the bytes 0xFF 0xFE, which never occur in UTF-8 JSON, so a reader
+// can resynchronize on it after a record whose writer died before its header was complete.
+constexpr uint32_t RecordMagic = 0xC0DEFEFFU;
+constexpr uint64_t HeaderSize = 64;
+constexpr uint64_t RecordAlignment = 8;
+
+uint64_t recordSpace(uint64_t payload) {
+    return alignTo(sizeof(RecordHeader) + payload, RecordAlignment);
+}
+
+}  // end of anonymous namespace
+
+SharedResultLog::~SharedResultLog() = default;
+
+    /**
+     * Function: SharedResultLog::open
+     *
+     * Description:
+     * Opens or creates the log file and maps it shared and writable. Concurrent openers serialize on a file lock only
+     * while the file is grown to 'capacity', so a late opener asking for less space never truncates records that are
+     * already there. A file that is not a log (wrong magic) is refused.
+     *
+     * Output:
+     * - The mapped log, or nullptr if it cannot be opened, grown or mapped.
+     */
+
+std::unique_ptr<SharedResultLog> SharedResultLog::open(StringRef path, uint64_t capacity) {
+    int fd;
+    if (sys::fs::openFileForReadWrite(path, fd, sys::fs::CD_OpenAlways, sys::fs::OF_None)) {
+        return nullptr;
+    }
+    uint64_t size = 0;
+    bool grown = false;
+    if (!sys::fs::lockFile(fd)) {
+        sys::fs::file_status status;
+        if (!sys::fs::status(fd, status)) {
+            size = status.getSize();
+            uint64_t wanted = std::max(capacity, HeaderSize + recordSpace(0));
+            grown = size >= wanted || !sys::fs::resize_file(fd, wanted);
+            size = std::max(size, wanted);
+        }
+        sys::fs::unlockFile(fd);
+    }
+
+    std::unique_ptr<SharedResultLog> log;
+    if (grown) {
+        std::error_code EC;
+        sys::fs::mapped_file_region region(sys::fs::convertFDToNativeFile(fd),
+                                           sys::fs::mapped_file_region::readwrite, size, 0, EC);
+        if (!EC) {
+            auto *header = reinterpret_cast<LogHeader *>(region.data());
+            // Every opener writes the same value, so the race on a fresh file is benign.
+            if (header->magic == 0) {
+                header->magic = LogMagic;
+            }
+            if (header->magic == LogMagic) {
+                log.reset(new SharedResultLog());
+                log->region = std::move(region);
+            }
+        }
+    }
+    sys::fs::closeFile(fd);
+    return log;
+}
+
+bool SharedResultLog::append(StringRef record) {
+    if (record.size() > UINT32_MAX) {
+        return false;
+    }
+    auto *header = reinterpret_cast<LogHeader *>(region.data());
+    uint64_t space = recordSpace(record.size());
+    uint64_t offset = header->tail.fetch_add(space, std::memory_order_relaxed);
+    if (offset + space > region.size() - HeaderSize) {
+        return false;
+    }
+    auto *recordHeader = reinterpret_cast<RecordHeader *>(region.data() + HeaderSize + offset);
+    recordHeader->magic = RecordMagic;
+    recordHeader->size = record.size();
+    std::memcpy(reinterpret_cast<char *>(recordHeader) + sizeof(RecordHeader), record.data(), record.size());
+    recordHeader->committed.store(1, std::memory_order_release);
+    return true;
+}
+
+std::string llvm::sharedResultFallbackDirectory(StringRef logPath) {
+    return (logPath + ".d").str();
+}
+
+namespace {
+
+    // Writes record to a fresh file in the fallback directory. The file only gets its .json name through a rename
+    // once it is complete, so readers never see a partial record.
+    bool writeFallbackFile(StringRef logPath, StringRef record) {
+        std::string directory = sharedResultFallbackDirectory(logPath);
+        if (sys::fs::create_directories(directory)) {
+            return false;
+        }
+        SmallString<256> model(directory);
+        sys::path::append(model, "tu-%%%%%%%%%%%%.tmp");
+        int fd;
+        SmallString<256> tempPath;
+        if (sys::fs::createUniqueFile(model, fd, tempPath)) {
+            return false;
+        }
+        {
+            raw_fd_ostream file(fd, /*shouldClose=*/true);
+            file << record;
+            file.close();
+            if (file.has_error()) {
+                file.clear_error();
+                sys::fs::remove(tempPath);
+                return false;
+            }
+        }
+        SmallString<256> finalPath(tempPath);
+        sys::path::replace_extension(finalPath, ".json");
+        if (sys::fs::rename(tempPath, finalPath)) {
+            sys::fs::remove(tempPath);
+            return false;
+        }
+        return true;
+    }
+
+}  // end of anonymous namespace
+
+bool llvm::publishSharedResult(StringRef logPath, uint64_t capacity, StringRef record) {
+    static std::mutex mutex;
+    static std::string openedPath;
+    static std::unique_ptr<SharedResultLog> log;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (openedPath != logPath) {
+            openedPath = logPath.str();
+            log = SharedResultLog::open(logPath, capacity);
+        }
+        if (log && log->append(record)) {
+            return true;
+        }
+    }
+    return writeFallbackFile(logPath, record);
+}
+
+    /**
+     * Function: readSharedResults
+     *
+     * Description:
+     * Walks the records of the log in reservation order, up to the tail or the end of the file. Committed records are
+     * passed to 'visit'; a record whose writer died after writing its header is skipped by its size, and bytes that do
+     * not start a record (a writer that died before its header) are skipped until the next record magic. The files of
+     * the fallback directory follow, sorted by name.
+     */
+
+bool llvm::readSharedResults(StringRef logPath, function_ref<void(StringRef)> visit) {
+    bool found = false;
+    ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
+        MemoryBuffer::getFile(logPath, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (buffer && (*buffer)->getBufferSize() >= HeaderSize) {
+        const char *data = (*buffer)->getBufferStart();
+        uint64_t magic, tail;
+        std::memcpy(&magic, data, sizeof(magic));
+        std::memcpy(&tail, data + offsetof(LogHeader, tail), sizeof(tail));
+        if (magic == LogMagic) {
+            found = true;
+            const char *records = data + HeaderSize;
+            uint64_t end = std::min<uint64_t>(tail, (*buffer)->getBufferSize() - HeaderSize);
+            uint64_t offset = 0;
+            while (offset + sizeof(RecordHeader) <= end) {
+                uint32_t recordMagic, size, committed;
+                std::memcpy(&recordMagic, records + offset + offsetof(RecordHeader, magic), sizeof(recordMagic));
+                if (recordMagic != RecordMagic) {
+                    offset += RecordAlignment;
+                    continue;
+                }
+                std::memcpy(&size, records + offset + offsetof(RecordHeader, size), sizeof(size));
+                std::memcpy(&committed, records + offset + offsetof(RecordHeader, committed), sizeof(committed));
+                uint64_t space = recordSpace(size);
+                if (offset + space > end) {
+                    break;
+                }
+                if (committed) {
+                    visit(StringRef(records + offset + sizeof(RecordHeader), size));
+                }
+                offset += space;
+            }
+        }
+    }
+
+    std::string directory = sharedResultFallbackDirectory(logPath);
+    if (sys::fs::is_directory(directory)) {
+        found = true;
+        std::vector<std::string> files;
+        std::error_code EC;
+        for (sys::fs::directory_iterator it(directory, EC), end; it != end && !EC; it.increment(EC)) {
+            if (sys::path::extension(it->path()) == ".json") {
+                files.push_back(it->path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const std::string &file : files) {
+            if (ErrorOr<std::unique_ptr<MemoryBuffer>> record = MemoryBuffer::getFile(file)) {
+                visit((*record)->getBuffer());
+            }
+        }
+    }
+    return found;
+}
+
+void llvm::removeSharedResults(StringRef logPath) {
+    sys::fs::remove(logPath);
+    sys::fs::remove_directories(sharedResultFallbackDirectory(logPath));
+}
@@ -31,3 +31,20 @@ int main() {
     FunctionB();
     return 0;
 }
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: FileCheck --check-prefix=JSON %s < %t/influential_variables.json
+
+// FunctionA reads 'a'; FunctionB gets it back as the result of FunctionA.
+// CHECK: Seminal Input Feature: Key variable: a, Line: 5
+// CHECK: Seminal Input Feature: Key variable: b, Line: 20
+
+// JSON:      "function": "FunctionA",
+// JSON:      "name": "a",
+// JSON:      "function": "FunctionB",
+// JSON:      "name": "b",
+// JSON:      "callee": "FunctionA",
+// JSON-NEXT: "line": 20
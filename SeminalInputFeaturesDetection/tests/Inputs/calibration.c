@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Workload of the calibration run the test budgets are relative to (see
+   budget.py): input read several ways, loops, nests and branches, about the
+   size of a test. It is not a test itself. */
+static int read_int(void) {
+    int v = 0;
+    scanf("%d", &v);
+    return v;
+}
+
+static void fill(int *dst, int n) {
+    for (int i = 0; i < n; i++)
+        dst[i] = i * 3 % 7;
+}
+
+int main(void) {
+    int rows = read_int();
+    int cols = read_int();
+    int mode;
+    scanf("%d", &mode);
+    int *cells = malloc(sizeof(int) * (rows > 0 ? rows : 1) * (cols > 0 ? cols : 1));
+    fill(cells, rows * cols);
+    long sum = 0;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (mode == 1)
+                sum += cells[r * cols + c];
+            else if (mode == 2)
+                sum -= cells[r * cols + c];
+            else
+                sum ^= cells[r * cols + c];
+        }
+    }
+    switch (mode) {
+    case 0:
+        printf("xor %ld\n", sum);
+        break;
+    default:
+        printf("sum %ld\n", sum);
+    }
+    FILE *f = fopen("calibration.txt", "r");
+    int ch, lines = 0;
+    while (f && (ch = fgetc(f)) != EOF)
+        if (ch == '\n')
+            lines++;
+    free(cells);
+    return lines;
+}
@@ -0,0 +1,35 @@
+#include <stdio.h>
+
+/* The wrappers of cross_module_wrapper.c, doing their work through static
+   helpers. A helper has no summary of its own, since other modules cannot
+   name it, so the summary of each wrapper must include what its helpers do:
+   read_n reads input, fill writes it through its parameter and step passes
+   its parameter on to run in cross_module_input.c. */
+
+void run(int n);
+
+static int read_n(void) {
+    int n;
+    scanf("%d", &n);
+    return n;
+}
+
+static void fill(int *p) {
+    *p = read_n();
+}
+
+void read_wrap(int *p) {
+    fill(p);
+}
+
+int read_value(void) {
+    return read_n();
+}
+
+static void step(int n) {
+    run(n + 1);
+}
+
+void run_wrap(int n) {
+    step(n);
+}
@@ -0,0 +1,14 @@
+/* Wrappers around the helpers of cross_module_input.c, compiled as a module of
+   their own: each one only passes its parameter on, so what it does with it
+   comes from the other module's summaries through the global merge. */
+
+void read_into(int *p);
+void run(int n);
+
+void read_wrap(int *p) {
+    read_into(p);
+}
+
+void run_wrap(int n) {
+    run(n + 1);
+}
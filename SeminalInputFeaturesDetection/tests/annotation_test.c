@@ -0,0 +1,44 @@
+#include <stdio.h>
+
+/* -seminal-annotate writes the features into the IR before the O2 pipeline
+   runs: the loop's llvm.loop metadata gets a seminal.features property next
+   to the hints clang emits, and the branch on 'mode' a !seminal.features
+   attachment. Both name the variable and the scanf call reaching them. */
+int main() {
+    int n, mode;
+    scanf("%d %d", &n, &mode);
+    if (mode > 2) {
+        puts("fast");
+    }
+    for (int i = 0; i < n; i++) {
+        printf("%d\n", i);
+    }
+    return 0;
+}
+
+// -disable-O0-optnone lets the O2 pipeline optimize main after annotation.
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -Xclang -disable-O0-optnone -emit-llvm -c %s -o %t/test.bc
+// RUN: %opt -passes='def-use-analysis,default<O2>' -seminal-annotate -S %t/test.bc -o %t/annotated.ll > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/annotated.ll
+
+// CHECK-LABEL: define {{.*}}i32 @main()
+// CHECK:       br i1 {{.*}}, !seminal.features ![[BRANCH:[0-9]+]]
+// CHECK:       br i1 {{.*}}, !llvm.loop ![[LOOP:[0-9]+]]
+
+// The branch names 'mode' and the scanf call on line 9, spelled out since
+// the verifier allows DILocations in no attachment but !dbg and llvm.loop.
+// CHECK-DAG: ![[MODE:[0-9]+]] = !DILocalVariable(name: "mode",
+// CHECK-DAG: ![[BRANCH]] = !{![[MODEF:[0-9]+]]}
+// CHECK-DAG: ![[MODEF]] = !{!"mode", !"IO", ![[MODE]], ![[SITE:[0-9]+]]}
+// CHECK-DAG: ![[SITE]] = !{i32 9, i32 5, !{{[0-9]+}}}
+
+// The loop keeps clang's mustprogress hint next to its features, which name
+// 'n' and the DILocation of the scanf call.
+// CHECK-DAG: ![[N:[0-9]+]] = !DILocalVariable(name: "n",
+// CHECK-DAG: ![[LOOP]] = distinct !{![[LOOP]], {{.*}}![[HINT:[0-9]+]], ![[PROPERTY:[0-9]+]]}
+// CHECK-DAG: ![[HINT]] = !{!"llvm.loop.mustprogress"}
+// CHECK-DAG: ![[PROPERTY]] = !{!"seminal.features", ![[LIST:[0-9]+]]}
+// CHECK-DAG: ![[LIST]] = !{![[NF:[0-9]+]]}
+// CHECK-DAG: ![[NF]] = !{!"n", !"IO", ![[N]], ![[SCANF:[0-9]+]]}
+// CHECK-DAG: ![[SCANF]] = !DILocation(line: 9, column: 5,
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Time and memory budgets of the regression suite (see lit.cfg.py).
+#
+#   budget.py calibrate --output calibration.json -- <command>
+#       Runs the command a few times and records its median CPU time and its
+#       peak resident memory.
+#
+#   budget.py check --calibration calibration.json --test <name>
+#                   [--time N] [--memory N] [--log usage.tsv] <command>
+#       Runs the command with its output passed through, then fails if its CPU
+#       time exceeds N times the calibration's (plus a small allowance for the
+#       clock resolution), or its peak memory N times the calibration's. The
+#       command's own failure is returned first. The measured ratios are
+#       appended to the log, to choose new budgets from.
+#
+# CPU time (user plus system) is used instead of wall time, so that tests
+# running in parallel do not slow each other below their budgets.
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+
+CALIBRATION_RUNS = 3
+CLOCK_ALLOWANCE = 0.05  # seconds
+
+
+def measure(command):
+    """Runs command; returns its exit status, CPU seconds and peak RSS in KiB."""
+    process = subprocess.Popen(command)
+    _, status, usage = os.wait4(process.pid, 0)
+    process.returncode = -os.WTERMSIG(status) if os.WIFSIGNALED(status) else os.WEXITSTATUS(status)
+    rss = usage.ru_maxrss
+    if sys.platform == "darwin":
+        rss //= 1024  # bytes there, KiB on Linux
+    return process.returncode, usage.ru_utime + usage.ru_stime, rss
+
+
+def calibrate(args):
+    times, peaks = [], []
+    for _ in range(CALIBRATION_RUNS):
+        status, cpu, rss = measure(args.command)
+        if status != 0:
+            sys.exit("budget.py: calibration command failed with status %d" % status)
+        times.append(cpu)
+        peaks.append(rss)
+    with open(args.output, "w") as output:
+        json.dump({"time": statistics.median(times), "memory": max(peaks)}, output)
+
+
+def check(args):
+    with open(args.calibration) as calibration_file:
+        calibration = json.load(calibration_file)
+    status, cpu, rss = measure(args.command)
+    time_ratio = cpu / max(calibration["time"], 1e-3)
+    memory_ratio = rss / max(calibration["memory"], 1)
+    if args.log:
+        with open(args.log, "a") as log:
+            log.write("%s\t%.2f\t%.2f\n" % (args.test, time_ratio, memory_ratio))
+    if status != 0:
+        return status
+    failed = False
+    if cpu > args.time * calibration["time"] + CLOCK_ALLOWANCE:
+        print("budget.py: %s: CPU time %.3f s is %.1fx the calibration run, over its budget of %gx"
+              % (args.test, cpu, time_ratio, args.time), file=sys.stderr)
+        failed = True
+    if rss > args.memory * calibration["memory"]:
+        print("budget.py: %s: peak memory %d KiB is %.1fx the calibration run, over its budget of %gx"
+              % (args.test, rss, memory_ratio, args.memory), file=sys.stderr)
+        failed = True
+    return 1 if failed and not args.report_only else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Runs a command within a time and memory budget.")
+    commands = parser.add_subparsers(dest="action", required=True)
+
+    calibrate_parser = commands.add_parser("calibrate")
+    calibrate_parser.add_argument("--output", required=True)
+    calibrate_parser.add_argument("command", nargs=argparse.REMAINDER)
+
+    check_parser = commands.add_parser("check")
+    check_parser.add_argument("--calibration", required=True)
+    check_parser.add_argument("--test", default="")
+    check_parser.add_argument("--time", type=float, default=4.0)
+    check_parser.add_argument("--memory", type=float, default=2.0)
+    check_parser.add_argument("--log")
+    check_parser.add_argument("--report-only", action="store_true")
+    check_parser.add_argument("command", nargs=argparse.REMAINDER)
+
+    args = parser.parse_args()
+    if args.command and args.command[0] == "--":
+        args.command = args.command[1:]
+    if not args.command:
+        parser.error("no command to run")
+    if args.action == "calibrate":
+        calibrate(args)
+        return 0
+    return check(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,64 @@
+#include <stdio.h>
+
+/* Input read and passed on through helpers. read_int() is an input call at
+   both of its call sites at every -seminal-context-depth, so 'n' and 'm' are
+   features. 'a' takes input through set() only at depth 1 or more, which
+   tells set(&a, n) from set(&b, 7); 'c' needs depth 2, since the input
+   reaches set() through fill(). 'b' and 'd' never do. */
+int read_int(void) {
+    int x;
+    scanf("%d", &x);
+    return x;
+}
+
+void set(int *dst, int v) {
+    *dst = v;
+}
+
+void fill(int *dst, int v) {
+    set(dst, v);
+}
+
+int main(void) {
+    int n = read_int();
+    int m = read_int();
+    int a, b, c, d;
+    set(&a, n);
+    set(&b, 7);
+    fill(&c, m);
+    fill(&d, 3);
+    int s = 0;
+    for (int i = 0; i < a; i++)
+        s += i;
+    for (int i = 0; i < b; i++)
+        s += i;
+    for (int i = 0; i < c; i++)
+        s += i;
+    for (int i = 0; i < d; i++)
+        s += i;
+    printf("%d\n", s);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/depth2.txt 2>&1
+// RUN: FileCheck --check-prefixes=CHECK,DEPTH1,DEPTH2 %s < %t/depth2.txt
+// RUN: FileCheck --check-prefix=NEVER %s < %t/depth2.txt
+// RUN: %budget %seminal -seminal-context-depth=1 %t/test.bc > %t/depth1.txt 2>&1
+// RUN: FileCheck --check-prefixes=CHECK,DEPTH1 %s < %t/depth1.txt
+// RUN: FileCheck --check-prefixes=NEVER,NODEPTH2 %s < %t/depth1.txt
+// RUN: %budget %seminal -seminal-context-depth=0 %t/test.bc > %t/depth0.txt 2>&1
+// RUN: FileCheck %s < %t/depth0.txt
+// RUN: FileCheck --check-prefixes=NEVER,NODEPTH1,NODEPTH2 %s < %t/depth0.txt
+
+// CHECK: Key variable: x, Line: 9
+// CHECK-DAG: Key variable: n, Line: 23
+// CHECK-DAG: Key variable: m, Line: 24
+// DEPTH1-DAG: Key variable: a, Line: 25
+// DEPTH2-DAG: Key variable: c, Line: 25
+
+// NEVER-NOT: Key variable: b,
+// NEVER-NOT: Key variable: d,
+// NODEPTH1-NOT: Key variable: a,
+// NODEPTH2-NOT: Key variable: c,
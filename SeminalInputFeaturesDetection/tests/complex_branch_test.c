@@ -13,3 +13,14 @@ int main() {
     }
     return 0;
 }
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+
+// 'z' is computed from the input but not read into.
+// CHECK: Seminal Input Feature:
+// CHECK-DAG: Key variable: x, Line: 4
+// CHECK-DAG: Key variable: y, Line: 4
+// CHECK-NOT: variable: z
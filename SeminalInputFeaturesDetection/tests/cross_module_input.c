@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+/* Input helpers and a loop kernel compiled as their own translation unit;
+   cross_module_main.c only sees their declarations. */
+
+int read_int() {
+    int x;
+    scanf("%d", &x);
+    return x;
+}
+
+void read_into(int *p) {
+    scanf("%d", p);
+}
+
+void run(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i++) {
+        s += i;
+    }
+    printf("%d\n", s);
+}
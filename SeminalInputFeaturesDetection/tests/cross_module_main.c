@@ -0,0 +1,28 @@
+int read_int();
+void read_into(int *p);
+void run(int n);
+
+int main() {
+    int n = read_int();
+    int m;
+    read_into(&m);
+    run(n);
+    return m;
+}
+
+// RUN: rm -rf %t && mkdir -p %t/bitcode && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/bitcode/main.bc
+// RUN: %clang -g -O0 -emit-llvm -c %S/cross_module_input.c -o %t/bitcode/input.bc
+// RUN: %budget %batch -whole-program %t/bitcode -o %t/out.json > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.json
+
+// Without the summaries of the other module main() sees no input at all.
+// CHECK:      "function": "main",
+// CHECK-NEXT: "influential_variables": [
+// CHECK-NEXT:   {
+// CHECK-NEXT:     "line": 6,
+// CHECK-NEXT:     "name": "n",
+// CHECK:          "type": "IO"
+// CHECK:          "line": 7,
+// CHECK-NEXT:     "name": "m",
+// CHECK:          "type": "IO"
@@ -0,0 +1,50 @@
+void read_wrap(int *p);
+void run_wrap(int n);
+
+/* main -> read_wrap -> read_into -> scanf and main -> run_wrap -> run, each
+   call into another module. The second run links the wrappers of
+   Inputs/cross_module_static_wrapper.c instead, which go through static
+   helpers of their own module. */
+int main() {
+    int n;
+    read_wrap(&n);
+    run_wrap(n);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t/bitcode && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/bitcode/main.bc
+// RUN: %clang -g -O0 -emit-llvm -c %S/Inputs/cross_module_wrapper.c -o %t/bitcode/wrapper.bc
+// RUN: %clang -g -O0 -emit-llvm -c %S/cross_module_input.c -o %t/bitcode/input.bc
+// RUN: %budget %batch -whole-program %t/bitcode -o %t/out.json > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.json
+// RUN: %batch -summarize %t/bitcode -o %t/summaries.json
+// RUN: %batch -merge-summaries %t/summaries.json -o %t/index.json
+// RUN: FileCheck --check-prefix=INDEX %s < %t/index.json
+// RUN: mkdir -p %t/static && cp %t/bitcode/main.bc %t/bitcode/input.bc %t/static
+// RUN: %clang -g -O0 -emit-llvm -c %S/Inputs/cross_module_static_wrapper.c -o %t/static/wrapper.bc
+// RUN: %budget %batch -whole-program %t/static -o %t/static.json > %t/static.txt 2>&1
+// RUN: FileCheck %s < %t/static.json
+// RUN: %batch -summarize %t/static -o %t/static_summaries.json
+// RUN: %batch -merge-summaries %t/static_summaries.json -o %t/static_index.json
+// RUN: FileCheck --check-prefixes=INDEX,STATIC %s < %t/static_index.json
+
+// The wrappers get the parameters of the functions they call.
+// STATIC:     "read_value": {
+// STATIC:       "returns_input": true
+// INDEX:      "read_wrap": {
+// INDEX:        "input_params": [
+// INDEX-NEXT:     0
+// INDEX:      "run_wrap": {
+// INDEX:        "loop_params": [
+// INDEX-NEXT:     0
+// STATIC-NOT: "read_n"
+// STATIC-NOT: "fill"
+// STATIC-NOT: "step"
+
+// CHECK:      "function": "main",
+// CHECK-NEXT: "influential_variables": [
+// CHECK-NEXT:   {
+// CHECK-NEXT:     "line": 7,
+// CHECK-NEXT:     "name": "n",
+// CHECK:          "type": "IO"
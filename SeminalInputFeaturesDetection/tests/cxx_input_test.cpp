@@ -0,0 +1,52 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* C++ input sources. 'n' is read by std::cin >>, 'line' by std::getline and
+   'f' is opened by std::ifstream, so all three are IO variables. 'v' is
+   filled from 'x' and bounds a loop through v.size(), so it is reported too,
+   with the extraction into 'x' as its origin. */
+int main() {
+    int n;
+    std::cin >> n;
+    std::string line;
+    std::getline(std::cin, line);
+    std::vector<int> v;
+    int x;
+    while (std::cin >> x)
+        v.push_back(x);
+    std::ifstream f("file.txt");
+    int m = 0;
+    f >> m;
+
+    long s = 0;
+    for (int i = 0; i < n; i++)
+        s += i;
+    for (size_t j = 0; j < line.size(); j++)
+        s += line[j];
+    for (size_t k = 0; k < v.size(); k++)
+        s += v[k];
+    for (int i = 0; i < m; i++)
+        s--;
+    std::cout << s << std::endl;
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clangxx -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget --time 8 %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: %seminal -seminal-cxx-input=false %t/test.bc > %t/c-only.txt 2>&1
+// RUN: FileCheck --check-prefix=C-ONLY %s < %t/c-only.txt
+
+// The template instantiations of the module are analyzed too, and take
+// twice the default time budget.
+// CHECK-DAG: Key variable: n, Line: 11
+// CHECK-DAG: Key variable: line, Line: 13
+// CHECK-DAG: Key variable: v, Line: 15
+// CHECK-DAG: Key variable: x, Line: 16
+// CHECK-DAG: Key variable: f, Line: 19
+// CHECK-DAG: Key variable: m, Line: 20
+
+// C-ONLY-NOT: Key variable: {{n|line|v|x|f|m}},
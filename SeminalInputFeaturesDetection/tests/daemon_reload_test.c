@@ -0,0 +1,60 @@
+#include <stdio.h>
+
+/* The daemon keeps the module loaded between requests. Rebuilding it with
+   CHANGED only changes main, so the reload re-analyzes main and reuses the
+   report of scale, which main calls but which does not depend on main. */
+int scale(int n) {
+    return n * 2;
+}
+
+int main() {
+    int n;
+    scanf("%d", &n);
+    int limit = scale(n);
+    for (int i = 0; i < limit; i++) {
+#ifdef CHANGED
+        printf("%d\n", i * 2);
+#else
+        printf("%d\n", i);
+#endif
+    }
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/old.bc
+// RUN: %clang -g -O0 -DCHANGED -emit-llvm -c %s -o %t/new.bc
+// RUN: cp %t/old.bc %t/test.bc
+// The daemon runs in the background, with a timeout in case a failing RUN
+// line leaves it without its shutdown request; its banner comes after listen.
+// RUN: sh -c 'timeout 120 %daemon -socket %t/seminal.sock > %t/daemon.log 2>&1 &'
+// RUN: sh -c 'for i in $(seq 100); do grep -q listening %t/daemon.log && exit 0; sleep 0.1; done; exit 1'
+// RUN: %daemon -socket %t/seminal.sock -send '{"op": "load", "module": "%t/test.bc"}' > %t/load.txt
+// RUN: FileCheck --check-prefix=LOAD %s < %t/load.txt
+// RUN: cp %t/new.bc %t/test.bc
+// RUN: %daemon -socket %t/seminal.sock -send '{"op": "load", "module": "%t/test.bc"}' > %t/reload.txt
+// RUN: FileCheck --check-prefix=RELOAD %s < %t/reload.txt
+// RUN: %daemon -socket %t/seminal.sock -send '{"op": "loop", "module": "%t/test.bc", "line": 14}' > %t/loop.txt
+// RUN: FileCheck --check-prefix=LOOP %s < %t/loop.txt
+// RUN: %daemon -socket %t/seminal.sock -send '{"op": "shutdown"}'
+
+// LOAD:      "analyzed": 2,
+// LOAD:      "ok": true,
+// LOAD-NEXT: "reused": 0
+
+// RELOAD:      "analyzed": 1,
+// RELOAD:      "ok": true,
+// RELOAD-NEXT: "reused": 1
+
+// LOOP:      "loops": [
+// LOOP:        "features": [
+// LOOP:            "name": "n",
+// LOOP:            "type": "IO"
+// LOOP:        "function": "main",
+// LOOP-NEXT:   "inputs": [
+// LOOP:            "callee": "{{(__isoc99_)?scanf}}",
+// LOOP:        "line": 14,
+// LOOP-NEXT:   "variables": [
+// LOOP-DAG:      "limit"
+// LOOP-DAG:      "n"
+// LOOP:      "ok": true
@@ -0,0 +1,40 @@
+#include <stdio.h>
+
+/* Only read_count() differs between the two versions: with -DNEW it reads the
+   count. main() compiles to the same code in both, but its loop is now bounded
+   by input, so the diff must analyze it again rather than skip it. */
+
+int read_count() {
+    int n;
+#ifdef NEW
+    scanf("%d", &n);
+#else
+    n = 10;
+#endif
+    return n;
+}
+
+int main() {
+    int count = read_count();
+    for (int i = 0; i < count; i++) {
+        printf("%d\n", i);
+    }
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/old.bc
+// RUN: %clang -g -O0 -emit-llvm -c -DNEW %s -o %t/new.bc
+// RUN: %budget %batch -diff %t/old.bc %t/new.bc -o %t/diff.json > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/diff.json
+
+// CHECK:      "function": "main",
+// CHECK:      "changed": [
+// CHECK:        "after": {
+// CHECK-NEXT:     "feature": "count",
+// CHECK:          "inputs": [
+// CHECK-NEXT:       "read_count"
+// CHECK:          "type": "IO"
+// CHECK:        "before": {
+// CHECK-NEXT:     "feature": "count",
+// CHECK:          "type": "Potential"
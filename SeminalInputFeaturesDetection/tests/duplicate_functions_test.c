@@ -0,0 +1,35 @@
+#include <stdio.h>
+
+/* Macro-generated copies with identical IR bodies; the analysis runs once
+   for the shape and reports each copy under its own variable names. */
+#define DEFINE_SUM(NAME, LIMIT)            \
+    int NAME() {                           \
+        int LIMIT;                         \
+        scanf("%d", &LIMIT);               \
+        int total = 0;                     \
+        for (int i = 0; i < LIMIT; i++) {  \
+            total += i;                    \
+        }                                  \
+        return total;                      \
+    }
+
+DEFINE_SUM(sum_rows, rows)
+DEFINE_SUM(sum_cols, cols)
+DEFINE_SUM(sum_depth, depth)
+
+int main() {
+    printf("%d\n", sum_rows() + sum_cols() + sum_depth());
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: %budget %seminal -seminal-dedup-functions=false %t/test.bc > %t/nodedup.txt 2>&1
+// RUN: FileCheck %s < %t/nodedup.txt
+
+// Each copy is reported under its own names, with or without deduplication.
+// CHECK: Key variable: rows, Line: 16
+// CHECK: Key variable: cols, Line: 17
+// CHECK: Key variable: depth, Line: 18
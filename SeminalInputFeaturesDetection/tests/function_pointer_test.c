@@ -23,3 +23,11 @@ int main() {
     func_ptr();
     return 0;
 }
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+
+// CHECK: Seminal Input Feature: Key variable: x, Line: 14
+// CHECK: Input-selected dispatch: Line: 23, Targets: foo, bar
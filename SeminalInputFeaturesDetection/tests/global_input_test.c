@@ -0,0 +1,47 @@
+#include <stdio.h>
+
+/* Input that reaches main() only through globals. init() reads 'n',
+   derive() copies it into 'h', and main() loops on 'h', so 'h' is a feature
+   of main() whose origin is the scanf in init(). 'lim' is set from a
+   constant and is not. */
+int n;
+int h;
+int lim = 10;
+
+void init(void) {
+    scanf("%d", &n);
+}
+
+void derive(void) {
+    h = n * 2;
+}
+
+int main(void) {
+    init();
+    derive();
+    int s = 0;
+    for (int i = 0; i < h; i++)
+        s += i;
+    for (int i = 0; i < lim; i++)
+        s -= i;
+    printf("%d\n", s);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: FileCheck --check-prefix=JSON %s < %t/influential_variables.json
+
+// CHECK-NOT: variable: lim
+// CHECK: Key variable: n, Line: 7
+// CHECK: Key variable: h, Line: 8
+// CHECK-NOT: variable: lim
+
+// JSON:      "function": "main",
+// JSON:      "name": "h",
+// JSON-NEXT: "origins": [
+// JSON-NEXT:   {
+// JSON-NEXT:     "callee": "{{(__isoc99_)?scanf}}",
+// JSON-NEXT:     "line": 12
@@ -0,0 +1,35 @@
+#include <stdio.h>
+
+/* Three inputs: 'width' bounds the inner loop of a nest, 'height' the outer
+   loop, and 'mode' only a branch outside the loops. The report ranks them
+   width, height, mode; -seminal-top-k=1 keeps only width. */
+int main() {
+    int width, height, mode;
+    scanf("%d %d %d", &width, &height, &mode);
+    int a = 1, b = 2, c = 3, d = 4;
+    long sum = 0;
+    if (mode > 2) {
+        sum = a + b;
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            sum += x * y + c * d;
+        }
+    }
+    printf("%ld\n", sum);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: %budget %seminal -seminal-top-k=1 %t/test.bc > %t/top1.txt 2>&1
+// RUN: FileCheck --check-prefix=TOP1 %s < %t/top1.txt
+
+// CHECK:      Seminal Input Feature: Key variable: width, Line: 7
+// CHECK-NEXT: Key variable: height, Line: 7
+// CHECK-NEXT: Key variable: mode, Line: 7
+
+// TOP1:     Seminal Input Feature: Key variable: width, Line: 7
+// TOP1-NOT: Key variable:
@@ -0,0 +1,51 @@
+#include <stdio.h>
+
+/* Calls through a constant table of functions. ops[k](&m) may call
+   read_val(), which reads input into its parameter, so 'm' is an IO
+   variable bounding the loop. 'k' is not read from input, so the call is a
+   dispatch but not an input-selected one; handlers[mode]() is, since 'mode'
+   comes from scanf. */
+int read_val(int *p) {
+    return scanf("%d", p);
+}
+
+int zero(int *p) {
+    *p = 0;
+    return 0;
+}
+
+void start(void) {
+    printf("start\n");
+}
+
+void stop(void) {
+    printf("stop\n");
+}
+
+int (*const ops[])(int *) = {read_val, zero};
+void (*const handlers[])(void) = {start, stop};
+
+int main(void) {
+    int k = 0;
+    int m;
+    ops[k](&m);
+    int s = 0;
+    for (int i = 0; i < m; i++)
+        s += i;
+    int mode;
+    scanf("%d", &mode);
+    handlers[mode & 1]();
+    printf("%d\n", s);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+
+// CHECK: Seminal Input Feature:
+// CHECK-DAG: Key variable: m, Line: 30
+// CHECK-DAG: Key variable: mode, Line: 35
+// CHECK-NOT: Input-selected dispatch: Line: 31
+// CHECK: Input-selected dispatch: Line: 37, Targets: start, stop
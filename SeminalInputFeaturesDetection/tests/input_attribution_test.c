@@ -0,0 +1,51 @@
+#include <stdio.h>
+
+/* Three input sites: the scanf into 'n' bounds the first loop through
+   'bound', the scanf into 'm' the second, and the fgetc of the fopen'ed file
+   only the branch inside it. Each feature's "origins" names its own call, and
+   each loop only the call that reaches its condition. */
+int main() {
+    int n, m, k;
+    FILE *f;
+    scanf("%d", &n);
+    scanf("%d", &m);
+    f = fopen("file.txt", "r");
+    k = fgetc(f);
+    int bound = n * 2;
+    int s = 0;
+    for (int i = 0; i < bound; i++)
+        s += i;
+    for (int j = 0; j < m; j++)
+        if (k > 3)
+            s--;
+    printf("%d\n", s);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: FileCheck --check-prefix=N %s < %t/influential_variables.json
+// RUN: FileCheck --check-prefix=M %s < %t/influential_variables.json
+
+// CHECK: Seminal Input Feature:
+// CHECK-DAG: Key variable: n, Line: 8
+// CHECK-DAG: Key variable: m, Line: 8
+// CHECK-DAG: Key variable: f, Line: 9
+
+// N:      "name": "n",
+// N-NEXT: "origins": [
+// N-NEXT:   {
+// N-NEXT:     "callee": "{{(__isoc99_)?scanf}}",
+// N-NEXT:     "line": 10
+// N-NEXT:   }
+// N-NEXT: ],
+
+// M:      "name": "m",
+// M-NEXT: "origins": [
+// M-NEXT:   {
+// M-NEXT:     "callee": "{{(__isoc99_)?scanf}}",
+// M-NEXT:     "line": 11
+// M-NEXT:   }
+// M-NEXT: ],
@@ -0,0 +1,60 @@
+# -*- Python -*-
+#
+# lit configuration of the regression suite. Every .c and .cpp file in this
+# directory is a test: its RUN lines compile it with clang, run the pass,
+# seminal-batch or seminal-daemon on the bitcode and check the console and
+# JSON output with FileCheck. The analysis runs under %budget (budget.py),
+# which fails a test whose CPU time or peak memory exceeds its budget, a
+# multiple of a calibration run made on the same machine when the suite
+# starts.
+#
+# Parameters (lit -D<name>=<value>):
+#   seminal_time_budget    default CPU time budget, in calibration runs (4)
+#   seminal_memory_budget  default peak memory budget, in calibration runs (2)
+#   seminal_budgets        0 to measure without failing, e.g. under sanitizers
+
+import os
+import subprocess
+import sys
+
+import lit.formats
+
+config.name = "SeminalInputFeatures"
+config.test_format = lit.formats.ShTest(execute_external=False)
+config.suffixes = [".c", ".cpp"]
+# Sources compiled by other tests' RUN lines, and the calibration workload.
+config.excludes = ["Inputs", "cross_module_input.c"]
+config.test_source_root = os.path.dirname(__file__)
+config.test_exec_root = os.path.join(config.seminal_obj_root, "tests")
+
+config.environment["PATH"] = os.pathsep.join([config.llvm_tools_dir, config.environment.get("PATH", "")])
+opt = [os.path.join(config.llvm_tools_dir, "opt"), "-load", config.plugin, "-load-pass-plugin", config.plugin]
+seminal = opt + ["-passes=def-use-analysis", "-disable-output"]
+
+# The calibration run: the pass on a fixed module, measured like the tests.
+budget = os.path.join(config.test_source_root, "budget.py")
+calibration = os.path.join(config.test_exec_root, "calibration.json")
+calibration_bc = os.path.join(config.test_exec_root, "calibration.bc")
+os.makedirs(config.test_exec_root, exist_ok=True)
+try:
+    subprocess.check_call([config.clang, "-g", "-O0", "-emit-llvm", "-c",
+                           os.path.join(config.test_source_root, "Inputs", "calibration.c"), "-o", calibration_bc])
+    subprocess.check_call([sys.executable, budget, "calibrate", "--output", calibration, "--"] +
+                          seminal + [calibration_bc], cwd=config.test_exec_root)
+except (OSError, subprocess.CalledProcessError) as error:
+    lit_config.fatal("calibration run failed: %s" % error)
+
+check_budgets = lit_config.params.get("seminal_budgets", "1") != "0"
+budget_command = "%s %s check --calibration %s --log %s --test %%s --time %s --memory %s%s" % (
+    sys.executable, budget, calibration, os.path.join(config.test_exec_root, "budget-usage.tsv"),
+    lit_config.params.get("seminal_time_budget", "4"), lit_config.params.get("seminal_memory_budget", "2"),
+    "" if check_budgets else " --report-only")
+
+# Applied in order and before lit's own %s and %t; %clangxx goes before its prefix %clang.
+config.substitutions.append(("%budget", budget_command))
+config.substitutions.append(("%seminal", " ".join(seminal)))
+config.substitutions.append(("%opt", " ".join(opt)))
+config.substitutions.append(("%batch", config.seminal_batch))
+config.substitutions.append(("%daemon", config.seminal_daemon))
+config.substitutions.append(("%clangxx", config.clangxx))
+config.substitutions.append(("%clang", config.clang))
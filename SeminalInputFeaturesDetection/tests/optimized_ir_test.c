@@ -0,0 +1,38 @@
+#include <stdio.h>
+
+void configure(int *limit);
+
+/* 'n' is copied into 'limit', whose address escapes, so the loop reads its
+   bound from memory. Without alias analysis the walks stop at that load and
+   'n' is credited with the loop only through its value flowing into 'limit'.
+   The -O2 build, analyzed in SSA form, reports the same feature as -O0. */
+int main() {
+    int n;
+    scanf("%d", &n);
+    int limit = n;
+    configure(&limit);
+    for (int i = 0; i < limit; i++) {
+        printf("%d\n", i);
+    }
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t/O0 %t/O2
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/O0/test.bc
+// RUN: %clang -g -O2 -emit-llvm -c %s -o %t/O2/test.bc
+// RUN: cd %t/O0 && %budget %seminal -seminal-use-aa=false %t/O0/test.bc > %t/O0/out.txt 2>&1
+// RUN: cd %t/O2 && %budget %seminal -seminal-use-aa=false %t/O2/test.bc > %t/O2/out.txt 2>&1
+// RUN: FileCheck %s < %t/O0/out.txt
+// RUN: FileCheck %s < %t/O2/out.txt
+// RUN: FileCheck --check-prefix=JSON %s < %t/O0/influential_variables.json
+// RUN: FileCheck --check-prefix=JSON %s < %t/O2/influential_variables.json
+
+// CHECK: Seminal Input Feature: Key variable: n, Line: 10
+// CHECK-NOT: variable:
+
+// The loop is credited to 'n' at both levels, by a score the block
+// frequencies of each build give it.
+// JSON:      "name": "n",
+// JSON:      "score": {{[1-9][0-9]*\.[0-9]+}},
+// JSON-NEXT: "type": "IO"
+// JSON-NOT:  "name":
@@ -0,0 +1,51 @@
+#include <stdio.h>
+
+/* 'rows' bounds a loop nest and 'steps' a single loop, so without a profile
+   rows ranks first. The training input (Inputs/profile_guided.txt) has
+   rows = 0 and steps = 100000: with its profile, steps is scored by the
+   iterations it controls, and rows, whose loops never iterate, is cold and
+   left out. */
+int main() {
+    int rows, steps;
+    scanf("%d %d", &rows, &steps);
+    long sum = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < rows; j++) {
+            sum += i * j;
+        }
+    }
+    for (int s = 0; s < steps; s++) {
+        sum += s;
+    }
+    printf("%ld\n", sum);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %clang -g -O0 -fprofile-generate %s -o %t/train
+// RUN: env LLVM_PROFILE_FILE=%t/train.profraw %t/train < %S/Inputs/profile_guided.txt
+// RUN: llvm-profdata merge %t/train.profraw -o %t/train.profdata
+// RUN: %budget %seminal %t/test.bc > %t/static.txt 2>&1
+// RUN: FileCheck --check-prefix=STATIC %s < %t/static.txt
+// RUN: %budget %seminal -seminal-profile=%t/train.profdata %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: FileCheck --check-prefix=JSON %s < %t/influential_variables.json
+// RUN: %seminal -seminal-profile=%t/train.profdata -seminal-suppress-cold=false %t/test.bc > %t/all.txt 2>&1
+// RUN: FileCheck --check-prefix=ALL %s < %t/all.txt
+
+// STATIC:      Seminal Input Feature: Key variable: rows, Line: 9
+// STATIC-NEXT: Key variable: steps, Line: 9
+
+// CHECK:     Seminal Input Feature: Key variable: steps, Line: 9
+// CHECK-NOT: Key variable: rows
+// CHECK:     1 features controlling only cold code not reported
+
+// The score is about the 100001 times the loop condition of 'steps' ran, as
+// BlockFrequencyInfo scales it from the branch weights.
+// JSON:     "name": "steps",
+// JSON:     "score": {{(99|100)[0-9][0-9][0-9]\.}}
+// JSON-NOT: "rows"
+
+// ALL:      Seminal Input Feature: Key variable: steps, Line: 9
+// ALL-NEXT: Key variable: rows, Line: 9
@@ -4,3 +4,20 @@ clang  -g -O0 -emit-llvm -c test_example1.c -o test_example1.bc
 llvm-dis hello.bc -o test_example1.ll
 opt -load-pass-plugin ../build/libDefUseAnalysisPass.so -passes=def-use-analysis -disable-output test_example1.bc
 
+
+# Same analysis inside the normal compile, without writing and re-parsing bitcode
+SEMINAL_AUTO_RUN=pipeline-start clang -g -O0 -fpass-plugin=../build/libDefUseAnalysisPass.so -c test_example1.c -o test_example1.o
+
+# Optimized build, analyzed in SSA form through dbg.value instead of dbg.declare
+clang -g -O2 -emit-llvm -c test_example1.c -o test_example1.O2.bc
+opt -load-pass-plugin ../build/libDefUseAnalysisPass.so -passes=def-use-analysis -disable-output test_example1.O2.bc
+
+# Concurrent runs appending to one shared log, compacted into a single result file
+for i in 1 2 3 4; do
+    SEMINAL_SHARED_LOG=$PWD/seminal.log opt -load-pass-plugin ../build/libDefUseAnalysisPass.so -passes=def-use-analysis -disable-output test_example1.bc &
+done
+wait
+../build/seminal-batch -compact-shared-log seminal.log -o influential_variables.json
+
+# Regression suite: FileCheck output checks with time and memory budgets
+lit -sv ../build/tests
@@ -0,0 +1,41 @@
+#include <stdio.h>
+
+/* Three modules published by separate runs to one shared log. The log is
+   created with no room for a record, so the first runs fall back to files in
+   seminal.log.d; the last run asks for a larger log, which grows it, and
+   appends there. b.bc is analyzed twice, as when make rebuilds it. The
+   compacted result has each module once. */
+int main() {
+    int n;
+    scanf("%d", &n);
+    int s = 0;
+    for (int i = 0; i < n; i++) {
+        s += i;
+    }
+    printf("%d\n", s);
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/a.bc
+// RUN: cp %t/a.bc %t/b.bc
+// RUN: cp %t/a.bc %t/c.bc
+// RUN: env SEMINAL_SHARED_LOG=%t/seminal.log %seminal -seminal-shared-log-size=0 %t/a.bc
+// RUN: env SEMINAL_SHARED_LOG=%t/seminal.log %seminal -seminal-shared-log-size=0 %t/b.bc
+// RUN: env SEMINAL_SHARED_LOG=%t/seminal.log %seminal -seminal-shared-log-size=0 %t/b.bc
+// RUN: env SEMINAL_SHARED_LOG=%t/seminal.log %seminal -seminal-shared-log-size=1 %t/c.bc
+// RUN: ls %t/seminal.log.d | FileCheck --check-prefix=FALLBACK %s
+// RUN: %batch -compact-shared-log %t/seminal.log -o %t/merged.json
+// RUN: grep '"module"' %t/merged.json | sort | FileCheck --check-prefix=MERGED %s
+// RUN: FileCheck --check-prefix=JSON %s < %t/merged.json
+
+// FALLBACK-COUNT-3: tu-{{.*}}.json
+// FALLBACK-NOT:     .json
+
+// MERGED:      "module": "{{.*}}a.bc"
+// MERGED-NEXT: "module": "{{.*}}b.bc"
+// MERGED-NEXT: "module": "{{.*}}c.bc"
+// MERGED-NOT:  "module"
+
+// JSON-COUNT-3: "function": "main",
+// JSON-NOT:     "function":
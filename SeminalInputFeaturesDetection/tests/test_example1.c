@@ -10,3 +10,27 @@ int main(){
    }
    printf("id=%d; sum=%d\n", id, n); 
 }
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// RUN: FileCheck --check-prefix=JSON %s < %t/influential_variables.json
+
+// 'id' is copied from 'n' but not written by input, so only 'n' is reported.
+// CHECK: Seminal Input Feature: Key variable: n, Line: 4
+// CHECK-NOT: variable:
+
+// JSON:      "function": "main",
+// JSON-NEXT: "influential_variables": [
+// JSON-NEXT:   {
+// JSON-NEXT:     "line": 4,
+// JSON-NEXT:     "name": "n",
+// JSON-NEXT:     "origins": [
+// JSON-NEXT:       {
+// JSON-NEXT:         "callee": "{{(__isoc99_)?scanf}}",
+// JSON-NEXT:         "line": 5
+// JSON-NEXT:       }
+// JSON-NEXT:     ],
+// JSON-NEXT:     "score": {{[0-9.]+}},
+// JSON-NEXT:     "type": "IO"
@@ -19,3 +19,13 @@ int main() {
     fclose(fp); 
     return 0;
 }
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+
+// The stream returned by fopen is the input; 'c' is read from it but not
+// written by an input call itself.
+// CHECK: Seminal Input Feature: Key variable: fp, Line: 5
+// CHECK-NOT: variable:
@@ -0,0 +1,54 @@
+#include <stdio.h>
+
+int process(int block_size) {
+    int sum = 0;
+    for (int i = 0; i < block_size; i++) {
+        sum += i * i;
+    }
+    return sum;
+}
+
+int main() {
+    int block_size;
+    scanf("%d", &block_size);
+    printf("sum=%d\n", process(block_size));
+    return 0;
+}
+
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clang -g -O0 -emit-llvm -c %s -o %t/test.bc
+// RUN: %budget %seminal %t/test.bc > %t/out.txt 2>&1
+// RUN: FileCheck %s < %t/out.txt
+// The pass skips optnone functions, so the clones are made from an -O1 build.
+// RUN: %clang -g -O1 -emit-llvm -c %s -o %t/opt.bc
+// RUN: %opt -passes=seminal-specialize -seminal-value-profile=%S/value_profile.json -S %t/opt.bc -o %t/spec.ll 2> %t/spec.txt
+// RUN: FileCheck --check-prefix=SPEC %s < %t/spec.ll
+// RUN: FileCheck --check-prefix=LOG %s < %t/spec.txt
+
+// CHECK: Key variable: block_size, Line: 12
+
+// The two entries of 128 in the profile add up to 1400 of 7400 executions, so
+// 128 is specialized after 64 and ahead of 17, once.
+// SPEC:       define {{.*}}i32 @process(i32 {{[^%]*}}%[[ARG:[0-9A-Za-z_.]+]])
+// SPEC-NEXT:  [[C64:%[0-9A-Za-z_.]+]] = icmp eq i32 %[[ARG]], 64
+// SPEC-NEXT:  br i1 [[C64]], label %seminal.spec, label %seminal.dispatch
+// SPEC:       seminal.spec:
+// SPEC-NEXT:  [[R64:%[0-9A-Za-z_.]+]] = call i32 @process.seminal.64()
+// SPEC-NEXT:  ret i32 [[R64]]
+// SPEC:       seminal.dispatch:
+// SPEC-NEXT:  [[C128:%[0-9A-Za-z_.]+]] = icmp eq i32 %[[ARG]], 128
+// SPEC-NEXT:  br i1 [[C128]], label %seminal.spec1, label %[[BODY:[0-9A-Za-z_.]+]]
+// SPEC:       seminal.spec1:
+// SPEC-NEXT:  [[R128:%[0-9A-Za-z_.]+]] = call i32 @process.seminal.128()
+// SPEC-NEXT:  ret i32 [[R128]]
+// SPEC:       [[BODY]]:
+// SPEC-NOT:   icmp eq i32 %[[ARG]],
+// SPEC-LABEL: define internal i32 @process.seminal.64()
+// SPEC:       icmp {{.*}}, 64
+// SPEC-LABEL: define internal i32 @process.seminal.128()
+// SPEC:       icmp {{.*}}, 128
+// SPEC-NOT:   @process.seminal.17
+
+// LOG:      Specialized process on block_size = 64 as process.seminal.64
+// LOG-NEXT: Specialized process on block_size = 128 as process.seminal.128
+// LOG-NOT: process.seminal.17
@@ -0,0 +1,815 @@
+//===- seminal-batch: analyze many bitcode modules in one process ---------===//
+//
+// Replaces one `opt -load-pass-plugin ... -passes=def-use-analysis` process per
+// module with a single process that:
+//   - expands directories, @file-lists and compile_commands.json into a list of
+//     bitcode files, largest first so the biggest modules do not straggle;
+//   - reads files on a prefetch thread, a bounded number ahead of the workers;
+//   - parses and analyzes on a work-stealing pool, one LLVMContext per worker;
+//   - streams per-module results to the output file on a writer thread.
+//
+// For cross-module precision without linking the program, -summarize writes
+// compact per-module taint summaries, -merge-summaries combines them into one
+// index, and -summary-index analyzes each module against that index.
+// -whole-program runs the three steps in one invocation.
+//
+// -compact-shared-log merges the shared result logs that concurrent plugin
+// runs (opt or clang -fpass-plugin with -seminal-shared-log) append to.
+//
+// -diff compares the feature -> loop edges of two versions of a program, for
+// performance review of a change. Functions whose hash is the same in both
+// versions, and files whose bytes are, are not analyzed, so a diff costs
+// about as much as the change. -edge-index saves one version's edges so the
+// baseline does not have to be re-analyzed for every change.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SeminalInputFeatures/FeatureDiff.h"
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "SeminalInputFeatures/SharedResultLog.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+using namespace llvm;
+using Json = nlohmann::json;
+
+static cl::list<std::string> InputPaths(
+    cl::Positional, cl::OneOrMore,
+    cl::desc("<bitcode file | directory | @file-list | compile_commands.json>..."));
+
+static cl::opt<std::string> OutputFile(
+    "o", cl::init("influential_variables.json"),
+    cl::desc("Output JSON file"), cl::value_desc("filename"));
+
+static cl::opt<unsigned> NumThreads(
+    "j", cl::init(0),
+    cl::desc("Number of analysis workers (default: number of hardware threads)"));
+
+static cl::opt<unsigned> PrefetchDepth(
+    "prefetch", cl::init(0),
+    cl::desc("Number of modules read ahead of the workers (default: twice the worker count)"));
+
+static cl::opt<bool> Verbose(
+    "v", cl::desc("Print each module's seminal input features to stderr"));
+
+static cl::opt<bool> Summarize(
+    "summarize",
+    cl::desc("Write per-module taint summaries of the exported functions instead of seminal features"));
+
+static cl::opt<bool> MergeSummaries(
+    "merge-summaries",
+    cl::desc("Merge the summary files given as inputs into one combined index written to -o"));
+
+static cl::opt<std::string> SummaryIndexFile(
+    "summary-index",
+    cl::desc("Combined summary index used to resolve calls into other modules"), cl::value_desc("filename"));
+
+static cl::opt<bool> WholeProgram(
+    "whole-program",
+    cl::desc("Summarize all inputs, merge the summaries, then analyze every module against the merged index"));
+
+static cl::opt<bool> CompactSharedLog(
+    "compact-shared-log",
+    cl::desc("Merge the shared result logs given as inputs into one result file written to -o, keeping the "
+             "latest record of each module, then remove the logs"));
+
+static cl::opt<bool> EdgeIndex(
+    "edge-index",
+    cl::desc("Write the seminal feature -> loop edges of the module given as input to -o, for a later -diff"));
+
+static cl::opt<bool> Diff(
+    "diff",
+    cl::desc("Write the seminal feature -> loop edges added, removed or changed between the two versions given as "
+             "inputs to -o; each version is a module, an edge index (-edge-index) or a directory of bitcode, "
+             "with modules matched by relative path"));
+
+namespace {
+
+struct ModuleTask {
+    std::string path;
+    uint64_t size = 0;
+    size_t order = 0;      // position in the order the prefetcher reads the tasks
+    std::promise<ErrorOr<std::unique_ptr<MemoryBuffer>>> buffer;
+};
+
+struct ModuleResult {
+    std::string path;
+    bool parsed = false;
+    Json functions;
+    Json memory;      // with -seminal-memory-report
+    std::string log;
+};
+
+    /**
+     * Function: collectInputs
+     *
+     * Description:
+     * Expands one command line input into bitcode paths. A directory is searched recursively for `.bc` files, `@list`
+     * names a file with one path per line, and a `compile_commands.json` contributes the output of every entry that
+     * emits bitcode (the `output` field, or the argument after `-o`), resolved against the entry's directory.
+     * Anything else is taken to be a bitcode or textual IR file.
+     */
+
+    void collectInputs(StringRef input, std::vector<std::string> &paths) {
+        if (!input.empty() && input.front() == '@') {
+            std::ifstream list(input.drop_front().str());
+            if (!list) {
+                errs() << "Cannot open file list " << input.drop_front() << "\n";
+                return;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                StringRef trimmed = StringRef(line).trim();
+                if (!trimmed.empty()) {
+                    paths.push_back(trimmed.str());
+                }
+            }
+            return;
+        }
+
+        if (sys::fs::is_directory(input)) {
+            std::error_code EC;
+            for (sys::fs::recursive_directory_iterator it(input, EC), end; it != end && !EC; it.increment(EC)) {
+                if (sys::path::extension(it->path()) == ".bc" && !sys::fs::is_directory(it->path())) {
+                    paths.push_back(it->path());
+                }
+            }
+            return;
+        }
+
+        if (sys::path::filename(input) == "compile_commands.json") {
+            std::ifstream file(input.str());
+            Json database = Json::parse(file, nullptr, /*allow_exceptions=*/false);
+            if (database.is_discarded() || !database.is_array()) {
+                errs() << "Malformed compilation database " << input << "\n";
+                return;
+            }
+            for (const auto &entry : database) {
+                if (!entry.is_object()) {
+                    continue;
+                }
+                std::string output;
+                if (entry.contains("output") && entry["output"].is_string()) {
+                    output = entry["output"].get<std::string>();
+                } else if (entry.contains("arguments") && entry["arguments"].is_array()) {
+                    const Json &args = entry["arguments"];
+                    for (size_t i = 0; i + 1 < args.size(); ++i) {
+                        if (args[i] == "-o" && args[i + 1].is_string()) {
+                            output = args[i + 1].get<std::string>();
+                        }
+                    }
+                } else if (entry.contains("command") && entry["command"].is_string()) {
+                    SmallVector<StringRef, 32> args;
+                    StringRef(entry["command"].get_ref<const std::string &>()).split(args, ' ', -1, false);
+                    for (size_t i = 0; i + 1 < args.size(); ++i) {
+                        if (args[i] == "-o") {
+                            output = args[i + 1].str();
+                        }
+                    }
+                }
+                if (sys::path::extension(output) != ".bc") {
+                    continue;
+                }
+                SmallString<256> resolved(output);
+                if (sys::path::is_relative(resolved) && entry.contains("directory") && entry["directory"].is_string()) {
+                    resolved = entry["directory"].get<std::string>();
+                    sys::path::append(resolved, output);
+                }
+                paths.push_back(std::string(resolved));
+            }
+            return;
+        }
+
+        paths.push_back(input.str());
+    }
+
+// Per-worker deques: the owner takes from the front (largest remaining task it
+// was dealt), idle workers steal the oldest front among the others. Files are
+// read in deal order, so that task is the one most likely read already; the
+// back of a deque is read last, and a thief taking it would wait for every
+// read before it.
+class WorkStealingQueues {
+public:
+    explicit WorkStealingQueues(unsigned workers) : queues(workers) {}
+
+    void push(unsigned worker, ModuleTask *task) {
+        std::lock_guard<std::mutex> lock(queues[worker].mutex);
+        queues[worker].tasks.push_back(task);
+    }
+
+    ModuleTask *pop(unsigned worker) {
+        {
+            Queue &own = queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                ModuleTask *task = own.tasks.front();
+                own.tasks.pop_front();
+                return task;
+            }
+        }
+        while (true) {
+            Queue *oldest = nullptr;
+            size_t oldestOrder = 0;
+            for (unsigned i = 1; i < queues.size(); ++i) {
+                Queue &victim = queues[(worker + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty() && (!oldest || victim.tasks.front()->order < oldestOrder)) {
+                    oldest = &victim;
+                    oldestOrder = victim.tasks.front()->order;
+                }
+            }
+            if (!oldest) {
+                return nullptr;
+            }
+            // The victim may have taken its front meanwhile; its next task is then the oldest one left there.
+            std::lock_guard<std::mutex> lock(oldest->mutex);
+            if (!oldest->tasks.empty()) {
+                ModuleTask *task = oldest->tasks.front();
+                oldest->tasks.pop_front();
+                return task;
+            }
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<ModuleTask *> tasks;
+    };
+    std::vector<Queue> queues;
+};
+
+// Bounds the number of file buffers read but not yet handed to a worker.
+class PrefetchWindow {
+public:
+    explicit PrefetchWindow(unsigned depth) : depth(depth) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return inFlight < depth; });
+        ++inFlight;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --inFlight;
+        }
+        cv.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned depth;
+    unsigned inFlight = 0;
+};
+
+// Streams module results to the output file as they complete.
+class ResultWriter {
+public:
+    explicit ResultWriter(const std::string &path) : file(path), thread([this] { drain(); }) {}
+
+    ~ResultWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        cv.notify_one();
+        thread.join();
+    }
+
+    bool ok() const { return static_cast<bool>(file); }
+
+    void push(ModuleResult result) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(result));
+        }
+        cv.notify_one();
+    }
+
+private:
+    void drain() {
+        file << "[";
+        bool first = true;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [&] { return done || !pending.empty(); });
+            if (pending.empty()) {
+                break;
+            }
+            std::vector<ModuleResult> batch;
+            batch.swap(pending);
+            lock.unlock();
+            for (ModuleResult &result : batch) {
+                if (!result.log.empty()) {
+                    errs() << result.log;
+                }
+                Json moduleJson;
+                moduleJson["module"] = result.path;
+                moduleJson["functions"] = std::move(result.functions);
+                if (!result.memory.is_null()) {
+                    moduleJson["memory"] = std::move(result.memory);
+                }
+                file << (first ? "\n" : ",\n") << moduleJson.dump(4);
+                first = false;
+            }
+            lock.lock();
+        }
+        file << "\n]\n";
+    }
+
+    std::ofstream file;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<ModuleResult> pending;
+    bool done = false;
+    std::thread thread;
+};
+
+enum class Phase { Analyze, Summarize };
+
+// Analysis state owned by one worker thread. The context outlives every module
+// the worker parses, and the analysis managers are cleared between modules.
+struct Worker {
+    LLVMContext context;
+    SeminalAnalysisManagers analyses;
+
+    explicit Worker(const FeatureSummaryIndex *index) : analyses(index) {}
+
+    ModuleResult process(const std::string &path, MemoryBufferRef buffer, Phase phase) {
+        ModuleResult result;
+        result.path = path;
+
+        SMDiagnostic err;
+        std::unique_ptr<Module> M = parseIR(buffer, err, context);
+        if (!M) {
+            raw_string_ostream OS(result.log);
+            err.print("seminal-batch", OS);
+            return result;
+        }
+        result.parsed = true;
+
+        if (phase == Phase::Summarize) {
+            result.functions = summarizeModule(*M, [&](Function &F) -> LoopInfo & {
+                return analyses.FAM.getResult<LoopAnalysis>(F);
+            }, &analyses.MAM.getResult<IndirectCallAnalysis>(*M));
+        } else {
+            std::string log;
+            raw_string_ostream logStream(log);
+            raw_ostream &OS = Verbose ? static_cast<raw_ostream &>(logStream) : nulls();
+            result.functions = Json::array();
+            analyses.prepare(*M);
+            analyzeModuleSeminalFeatures(*M, analyses.FAM, result.functions, OS, &result.memory);
+            if (Verbose) {
+                result.log = path + ":\n" + logStream.str();
+            }
+        }
+        analyses.FAM.clear();
+        analyses.MAM.clear();
+        return result;
+    }
+};
+
+    /**
+     * Function: processModules
+     *
+     * Description:
+     * Runs one phase over every module in 'paths' and hands each module's result to 'consume', which may be called
+     * concurrently from several workers. Modules are scheduled largest first on per-worker deques with stealing, file
+     * reads run on a prefetch thread a bounded number of modules ahead, and each worker parses into its own context.
+     *
+     * Output:
+     * - The number of modules that could not be read or parsed.
+     */
+
+    unsigned processModules(const std::vector<std::string> &paths, Phase phase, const FeatureSummaryIndex *index,
+                            const std::function<void(ModuleResult)> &consume) {
+        std::vector<std::unique_ptr<ModuleTask>> tasks;
+        for (const std::string &path : paths) {
+            auto task = std::make_unique<ModuleTask>();
+            task->path = path;
+            if (sys::fs::file_size(path, task->size)) {
+                errs() << "Cannot stat " << path << ", skipping\n";
+                continue;
+            }
+            tasks.push_back(std::move(task));
+        }
+        // Largest first: the biggest modules start immediately instead of
+        // straggling at the end of the run.
+        std::stable_sort(tasks.begin(), tasks.end(),
+                         [](const std::unique_ptr<ModuleTask> &a, const std::unique_ptr<ModuleTask> &b) {
+                             return a->size > b->size;
+                         });
+
+        unsigned workerCount = NumThreads ? NumThreads : std::max(1u, std::thread::hardware_concurrency());
+        workerCount = std::max(1u, std::min<unsigned>(workerCount, tasks.size()));
+        // Cores the workers leave idle help them with their largest functions.
+        if (phase == Phase::Analyze && std::thread::hardware_concurrency() > workerCount) {
+            shareSeminalWalkThreads(std::thread::hardware_concurrency() - workerCount);
+        }
+        WorkStealingQueues queues(workerCount);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            tasks[i]->order = i;
+            queues.push(i % workerCount, tasks[i].get());
+        }
+
+        PrefetchWindow window(PrefetchDepth ? PrefetchDepth : 2 * workerCount);
+        std::thread prefetcher([&] {
+            for (auto &task : tasks) {
+                window.acquire();
+                task->buffer.set_value(MemoryBuffer::getFile(task->path));
+            }
+        });
+
+        std::atomic<unsigned> failures{0};
+        std::vector<std::thread> workers;
+        for (unsigned id = 0; id < workerCount; ++id) {
+            workers.emplace_back([&, id] {
+                Worker worker(index);
+                while (ModuleTask *task = queues.pop(id)) {
+                    ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = task->buffer.get_future().get();
+                    window.release();
+                    if (!buffer) {
+                        errs() << "Cannot read " << task->path << ": " << buffer.getError().message() << "\n";
+                        ++failures;
+                        continue;
+                    }
+                    ModuleResult result = worker.process(task->path, (*buffer)->getMemBufferRef(), phase);
+                    if (!result.parsed) {
+                        ++failures;
+                    }
+                    consume(std::move(result));
+                }
+            });
+        }
+
+        for (std::thread &t : workers) {
+            t.join();
+        }
+        prefetcher.join();
+        return failures;
+    }
+
+    // Runs one phase and streams its per-module results to OutputFile.
+    int writeModuleResults(const std::vector<std::string> &paths, Phase phase, const FeatureSummaryIndex *index) {
+        ResultWriter writer(OutputFile);
+        if (!writer.ok()) {
+            errs() << "Cannot open " << OutputFile << " for writing\n";
+            return 1;
+        }
+        unsigned failures = processModules(paths, phase, index, [&](ModuleResult result) {
+            writer.push(std::move(result));
+        });
+        return failures ? 1 : 0;
+    }
+
+    bool writeIndex(const FeatureSummaryIndex &index) {
+        std::ofstream file(OutputFile);
+        if (!file) {
+            errs() << "Cannot open " << OutputFile << " for writing\n";
+            return false;
+        }
+        file << index.toJson().dump(4) << "\n";
+        return true;
+    }
+
+    // Merges the per-module summary files written by -summarize into one combined index.
+    int mergeSummaryFiles() {
+        FeatureSummaryIndex index;
+        for (const std::string &path : InputPaths) {
+            std::ifstream file(path);
+            Json summaries = Json::parse(file, nullptr, /*allow_exceptions=*/false);
+            if (summaries.is_discarded() || !summaries.is_array()) {
+                errs() << "Malformed summary file " << path << "\n";
+                return 1;
+            }
+            for (const auto &moduleSummary : summaries) {
+                if (moduleSummary.is_object() && moduleSummary.contains("functions")) {
+                    index.addModule(moduleSummary["functions"]);
+                }
+            }
+        }
+        index.propagate();
+        return writeIndex(index) ? 0 : 1;
+    }
+
+    /**
+     * Function: compactSharedLogs
+     *
+     * Description:
+     * Reads every record of the shared result logs given as inputs, including their fallback files, and writes them to
+     * OutputFile in the format of the analysis phase. A module analyzed more than once (e.g. rebuilt during the same
+     * make run) keeps its latest record, at the position of its first one. The logs are removed once the output is
+     * written, so the next build starts from an empty log.
+     */
+
+    int compactSharedLogs() {
+        std::vector<std::string> order;
+        StringMap<Json> modules;
+        for (const std::string &path : InputPaths) {
+            bool found = readSharedResults(path, [&](StringRef record) {
+                Json moduleJson = Json::parse(record.begin(), record.end(), nullptr, /*allow_exceptions=*/false);
+                if (moduleJson.is_discarded() || !moduleJson.is_object() || !moduleJson.contains("module") ||
+                    !moduleJson["module"].is_string()) {
+                    errs() << "Skipping a malformed record in " << path << "\n";
+                    return;
+                }
+                std::string module = moduleJson["module"].get<std::string>();
+                auto inserted = modules.try_emplace(module);
+                if (inserted.second) {
+                    order.push_back(module);
+                }
+                inserted.first->second = std::move(moduleJson);
+            });
+            if (!found) {
+                errs() << "No shared result log " << path << "\n";
+                return 1;
+            }
+        }
+
+        std::ofstream file(OutputFile);
+        if (!file) {
+            errs() << "Cannot open " << OutputFile << " for writing\n";
+            return 1;
+        }
+        file << "[";
+        for (size_t i = 0; i < order.size(); ++i) {
+            file << (i ? ",\n" : "\n") << modules[order[i]].dump(4);
+        }
+        file << "\n]\n";
+        file.close();
+        if (!file) {
+            errs() << "Cannot write " << OutputFile << "\n";
+            return 1;
+        }
+        for (const std::string &path : InputPaths) {
+            removeSharedResults(path);
+        }
+        return 0;
+    }
+
+// One version of a module for -diff: an edge index, or a module parsed into its own context.
+struct DiffVersion {
+    LLVMContext context;
+    std::unique_ptr<Module> module;
+    FeatureEdgeIndex index;
+    std::vector<std::pair<std::string, uint64_t>> hashes;
+};
+
+    // Opens one version; an empty path stands for a module that does not exist in this version.
+    bool openVersion(const std::string &path, DiffVersion &version) {
+        if (path.empty()) {
+            return true;
+        }
+        if (sys::path::extension(path) == ".json") {
+            if (!version.index.load(path)) {
+                return false;
+            }
+            for (const FunctionEdges &function : version.index.functions) {
+                version.hashes.emplace_back(function.function, function.hash);
+            }
+            return true;
+        }
+        SMDiagnostic err;
+        version.module = parseIRFile(path, err, version.context);
+        if (!version.module) {
+            err.print("seminal-batch", errs());
+            return false;
+        }
+        version.hashes = hashModuleFunctions(*version.module);
+        return true;
+    }
+
+    // Fills in the edges of a parsed version, analyzing only the functions whose hash differs in the other version.
+    void buildEdges(DiffVersion &version, const DiffVersion &other, const FeatureSummaryIndex *summaries) {
+        if (!version.module) {
+            return;
+        }
+        StringMap<uint64_t> otherHashes;
+        for (const auto &entry : other.hashes) {
+            otherHashes[entry.first] = entry.second;
+        }
+        version.index = buildFeatureEdgeIndex(*version.module, summaries, [&](StringRef name, uint64_t hash) {
+            auto it = otherHashes.find(name);
+            return it == otherHashes.end() || it->second != hash;
+        });
+    }
+
+    bool sameContents(const std::string &a, const std::string &b) {
+        if (a.empty() || b.empty() || sys::path::extension(a) == ".json" || sys::path::extension(b) == ".json") {
+            return false;
+        }
+        ErrorOr<std::unique_ptr<MemoryBuffer>> first = MemoryBuffer::getFile(a);
+        ErrorOr<std::unique_ptr<MemoryBuffer>> second = MemoryBuffer::getFile(b);
+        return first && second && (*first)->getBuffer() == (*second)->getBuffer();
+    }
+
+    /**
+     * Function: diffModule
+     *
+     * Description:
+     * Diffs the feature -> loop edges of two versions of one module, either of which may be missing (empty path).
+     * Identical files are skipped unread by the parser; otherwise both versions are hashed first, and only functions
+     * that are new or whose hash changed are analyzed.
+     *
+     * Output:
+     * - The diffFeatureEdges entries, or a null JSON value if a version cannot be opened.
+     */
+
+    Json diffModule(const std::string &beforePath, const std::string &afterPath, const FeatureSummaryIndex *summaries) {
+        if (sameContents(beforePath, afterPath)) {
+            return Json::array();
+        }
+        DiffVersion before, after;
+        if (!openVersion(beforePath, before) || !openVersion(afterPath, after)) {
+            return Json();
+        }
+        buildEdges(before, after, summaries);
+        buildEdges(after, before, summaries);
+
+        StringMap<uint64_t> oldHashes;
+        for (const auto &entry : before.hashes) {
+            oldHashes[entry.first] = entry.second;
+        }
+        unsigned unchanged = 0;
+        for (const auto &entry : after.hashes) {
+            auto it = oldHashes.find(entry.first);
+            unchanged += it != oldHashes.end() && it->second == entry.second;
+        }
+        if (Verbose) {
+            errs() << (afterPath.empty() ? beforePath : afterPath) << ": " << after.hashes.size() << " functions, "
+                   << unchanged << " unchanged and skipped\n";
+        }
+        return diffFeatureEdges(before.index, after.index);
+    }
+
+    // Relative paths of the .bc files under 'directory'.
+    std::set<std::string> bitcodeFiles(StringRef directory) {
+        std::set<std::string> files;
+        std::error_code EC;
+        for (sys::fs::recursive_directory_iterator it(directory, EC), end; it != end && !EC; it.increment(EC)) {
+            StringRef path = it->path();
+            if (sys::path::extension(path) == ".bc" && !sys::fs::is_directory(path)) {
+                files.insert(path.drop_front(directory.size()).ltrim("/").str());
+            }
+        }
+        return files;
+    }
+
+    /**
+     * Function: diffVersions
+     *
+     * Description:
+     * Runs -diff on the two inputs. Two directories are compared module by module, pairing files by their path relative
+     * to each directory; a module present on one side only has all its edges added or removed. The output lists the
+     * modules with changed edges, in the format {"module", "functions": [diffFeatureEdges entries]}.
+     */
+
+    int diffVersions(const FeatureSummaryIndex *summaries) {
+        if (InputPaths.size() != 2) {
+            errs() << "-diff needs exactly two inputs, the version before and the version after\n";
+            return 1;
+        }
+        const std::string &beforeInput = InputPaths[0], &afterInput = InputPaths[1];
+        std::vector<std::pair<std::string, std::string>> pairs;
+        std::vector<std::string> names;
+        if (sys::fs::is_directory(beforeInput) && sys::fs::is_directory(afterInput)) {
+            std::set<std::string> oldFiles = bitcodeFiles(beforeInput), newFiles = bitcodeFiles(afterInput);
+            std::set<std::string> all(oldFiles);
+            all.insert(newFiles.begin(), newFiles.end());
+            for (const std::string &file : all) {
+                SmallString<256> oldPath(beforeInput), newPath(afterInput);
+                sys::path::append(oldPath, file);
+                sys::path::append(newPath, file);
+                pairs.emplace_back(oldFiles.count(file) ? std::string(oldPath) : "",
+                                   newFiles.count(file) ? std::string(newPath) : "");
+                names.push_back(file);
+            }
+        } else {
+            pairs.emplace_back(beforeInput, afterInput);
+            names.push_back(afterInput);
+        }
+
+        Json modulesJson = Json::array();
+        bool failed = false;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            Json functionsJson = diffModule(pairs[i].first, pairs[i].second, summaries);
+            if (functionsJson.is_null()) {
+                failed = true;
+            } else if (!functionsJson.empty()) {
+                modulesJson.push_back({{"module", names[i]}, {"functions", std::move(functionsJson)}});
+            }
+        }
+        std::ofstream file(OutputFile);
+        if (!file) {
+            errs() << "Cannot open " << OutputFile << " for writing\n";
+            return 1;
+        }
+        file << modulesJson.dump(4) << "\n";
+        return failed ? 1 : 0;
+    }
+
+    // Writes the edge index of the one module given as input, every function analyzed.
+    int writeEdgeIndex(const FeatureSummaryIndex *summaries) {
+        if (InputPaths.size() != 1) {
+            errs() << "-edge-index needs exactly one input module\n";
+            return 1;
+        }
+        LLVMContext context;
+        SMDiagnostic err;
+        std::unique_ptr<Module> M = parseIRFile(InputPaths[0], err, context);
+        if (!M) {
+            err.print("seminal-batch", errs());
+            return 1;
+        }
+        FeatureEdgeIndex index = buildFeatureEdgeIndex(*M, summaries, [](StringRef, uint64_t) { return true; });
+        std::ofstream file(OutputFile);
+        if (!file) {
+            errs() << "Cannot open " << OutputFile << " for writing\n";
+            return 1;
+        }
+        file << index.toJson().dump(4) << "\n";
+        return 0;
+    }
+
+}  // end of anonymous namespace
+
+int main(int argc, char **argv) {
+    InitLLVM X(argc, argv);
+    cl::ParseCommandLineOptions(argc, argv, "Seminal input feature batch analysis\n");
+
+    if (MergeSummaries) {
+        return mergeSummaryFiles();
+    }
+    if (CompactSharedLog) {
+        return compactSharedLogs();
+    }
+
+    if (EdgeIndex || Diff) {
+        FeatureSummaryIndex index;
+        if (!SummaryIndexFile.empty() && !index.load(SummaryIndexFile)) {
+            return 1;
+        }
+        const FeatureSummaryIndex *summaries = SummaryIndexFile.empty() ? nullptr : &index;
+        return EdgeIndex ? writeEdgeIndex(summaries) : diffVersions(summaries);
+    }
+
+    std::vector<std::string> paths;
+    for (const std::string &input : InputPaths) {
+        collectInputs(input, paths);
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    if (Summarize) {
+        return writeModuleResults(paths, Phase::Summarize, nullptr);
+    }
+
+    FeatureSummaryIndex index;
+    bool haveIndex = false;
+    if (WholeProgram) {
+        // Only summaries are kept across modules: each module is dropped as
+        // soon as its summary has been merged into the index.
+        std::mutex indexMutex;
+        unsigned failures = processModules(paths, Phase::Summarize, nullptr, [&](ModuleResult result) {
+            std::lock_guard<std::mutex> lock(indexMutex);
+            index.addModule(result.functions);
+        });
+        if (failures) {
+            return 1;
+        }
+        index.propagate();
+        haveIndex = true;
+    } else if (!SummaryIndexFile.empty()) {
+        if (!index.load(SummaryIndexFile)) {
+            return 1;
+        }
+        haveIndex = true;
+    }
+    return writeModuleResults(paths, Phase::Analyze, haveIndex ? &index : nullptr);
+}
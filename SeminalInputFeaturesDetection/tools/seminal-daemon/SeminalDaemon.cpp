@@ -0,0 +1,523 @@
+//===- seminal-daemon: answer seminal feature queries over a local socket -===//
+//
+// Keeps parsed modules and their analysis results resident and answers
+// queries on a Unix domain socket, so an IDE or triage tool asking many small
+// questions about one large module pays for the parse and the analysis once.
+//
+// The protocol is one JSON object per line in each direction. Requests:
+//   {"op": "load", "module": "a.bc"}       parse and analyze; on a reload only
+//                                          the functions whose body or debug
+//                                          locations changed are re-analyzed
+//   {"op": "unload", "module": "a.bc"}
+//   {"op": "list"}                         loaded modules
+//   {"op": "functions", "module": "a.bc"}  function names and feature counts
+//   {"op": "function", "module": "a.bc", "function": "f"}
+//   {"op": "loop", "module": "a.bc", "line": 12 [, "function": "f"]}
+//   {"op": "branch", "module": "a.bc", "line": 12 [, "function": "f"]}
+//                                          the loops (branches) starting at a
+//                                          line, their condition variables, the
+//                                          input calls reaching them and the
+//                                          features among them
+//   {"op": "shutdown"}
+// Every reply has "ok"; failed requests carry "error" instead of results.
+//
+// `seminal-daemon -send '<request>'` sends one request to a running daemon
+// and prints the reply.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SeminalInputFeatures/FeatureDiff.h"
+#include "SeminalInputFeatures/FeatureSummary.h"
+#include "SeminalInputFeatures/IndirectCalls.h"
+#include "SeminalInputFeatures/SeminalFeatureAnalysis.h"
+#include "SeminalInputFeatures/SeminalFeatures.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "nlohmann/json.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace llvm;
+using Json = nlohmann::json;
+
+static cl::opt<std::string> SocketPath(
+    "socket", cl::init("seminal.sock"),
+    cl::desc("Unix domain socket the daemon listens on"), cl::value_desc("path"));
+
+static cl::opt<std::string> SummaryIndexFile(
+    "summary-index",
+    cl::desc("Combined summary index used to resolve calls into other modules"), cl::value_desc("filename"));
+
+static cl::opt<std::string> SendRequest(
+    "send",
+    cl::desc("Send this JSON request to the daemon listening on -socket, print the reply and exit"),
+    cl::value_desc("request"));
+
+namespace {
+
+struct FunctionEntry {
+    uint64_t hash = 0;
+    SeminalFunctionReport report;
+};
+
+// A module kept resident with its analysis managers. It is never modified once loaded; a reload builds a new one and
+// replaces it, so queries running concurrently keep the version they started with.
+struct LoadedModule {
+    LLVMContext context;
+    std::unique_ptr<Module> module;
+    SeminalAnalysisManagers analyses;
+    std::vector<std::string> order;           // defined functions, in module order
+    StringMap<FunctionEntry> functions;
+
+    explicit LoadedModule(const FeatureSummaryIndex *index) : analyses(index) {}
+};
+
+    const char *kindName(SeminalFeatureKind kind) {
+        return kind == SeminalFeatureKind::IO ? "IO" : "Potential";
+    }
+
+    Json inputCallsJson(const std::vector<SeminalInputCallReport> &calls) {
+        Json json = Json::array();
+        for (const SeminalInputCallReport &call : calls) {
+            json.push_back({{"callee", call.callee}, {"line", call.line}});
+        }
+        return json;
+    }
+
+    Json variableJson(const SeminalVariableReport &variable) {
+        Json json;
+        json["name"] = variable.name;
+        json["line"] = variable.line;
+        json["type"] = kindName(variable.kind);
+        json["score"] = variable.score;
+        json["input_lines"] = variable.inputLines;
+        json["origins"] = inputCallsJson(variable.origins);
+        return json;
+    }
+
+    Json controlPointJson(const SeminalControlPointReport &point, const SeminalFunctionReport &function) {
+        Json json;
+        json["function"] = function.function;
+        json["line"] = point.line;
+        json["variables"] = point.variables;
+        json["inputs"] = inputCallsJson(point.inputs);
+        if (point.loopDepth) {
+            json["depth"] = point.loopDepth;
+        }
+        Json features = Json::array();
+        for (const SeminalVariableReport &variable : function.variables) {
+            if (llvm::is_contained(point.variables, variable.name)) {
+                features.push_back(variableJson(variable));
+            }
+        }
+        json["features"] = std::move(features);
+        return json;
+    }
+
+    Json functionJson(const SeminalFunctionReport &report) {
+        Json json;
+        json["function"] = report.function;
+        json["influential_variables"] = Json::array();
+        for (const SeminalVariableReport &variable : report.variables) {
+            json["influential_variables"].push_back(variableJson(variable));
+        }
+        json["loops"] = Json::array();
+        for (const SeminalControlPointReport &loop : report.loops) {
+            json["loops"].push_back(controlPointJson(loop, report));
+        }
+        json["branches"] = Json::array();
+        for (const SeminalControlPointReport &branch : report.branches) {
+            json["branches"].push_back(controlPointJson(branch, report));
+        }
+        json["input_calls"] = inputCallsJson(report.inputCalls);
+        json["input_dispatch"] = Json::array();
+        for (const SeminalDispatchReport &dispatch : report.dispatches) {
+            json["input_dispatch"].push_back({{"line", dispatch.line},
+                                              {"targets", dispatch.targets},
+                                              {"variables", dispatch.variables},
+                                              {"inputs", inputCallsJson(dispatch.inputs)}});
+        }
+        if (report.degraded) {
+            json["degraded"] = report.degradedReason;
+        }
+        return json;
+    }
+
+    Json errorReply(const Twine &message) {
+        return {{"ok", false}, {"error", message.str()}};
+    }
+
+class Daemon {
+public:
+    explicit Daemon(const FeatureSummaryIndex *index) : index(index) {}
+
+    // Answers one request. Safe to call from several connections at once.
+    Json handle(const Json &request, bool &shutdown) {
+        if (!request.is_object() || !request.contains("op") || !request["op"].is_string()) {
+            return errorReply("request must be an object with an \"op\"");
+        }
+        const std::string &op = request["op"].get_ref<const std::string &>();
+        if (op == "shutdown") {
+            shutdown = true;
+            return {{"ok", true}};
+        }
+        if (op == "list") {
+            std::lock_guard<std::mutex> lock(mutex);
+            Json names = Json::array();
+            for (const auto &entry : modules) {
+                names.push_back(entry.first);
+            }
+            return {{"ok", true}, {"modules", names}};
+        }
+
+        static const std::set<std::string> moduleOps = {"load", "unload", "functions", "function", "loop", "branch"};
+        if (!moduleOps.count(op)) {
+            return errorReply("unknown op " + op);
+        }
+        if (!request.contains("module") || !request["module"].is_string()) {
+            return errorReply("missing \"module\"");
+        }
+        std::string path = modulePath(request["module"].get<std::string>());
+        if (op == "load") {
+            return load(path);
+        }
+        if (op == "unload") {
+            std::lock_guard<std::mutex> lock(mutex);
+            return modules.erase(path) ? Json{{"ok", true}} : errorReply(path + " is not loaded");
+        }
+
+        std::shared_ptr<const LoadedModule> loaded = find(path);
+        if (!loaded) {
+            return errorReply(path + " is not loaded");
+        }
+        if (op == "functions") {
+            Json functions = Json::array();
+            for (const std::string &name : loaded->order) {
+                const SeminalFunctionReport &report = loaded->functions.find(name)->second.report;
+                functions.push_back({{"function", name}, {"features", report.variables.size()},
+                                     {"loops", report.loops.size()}});
+            }
+            return {{"ok", true}, {"functions", functions}};
+        }
+        if (op == "function") {
+            if (!request.contains("function") || !request["function"].is_string()) {
+                return errorReply("missing \"function\"");
+            }
+            auto it = loaded->functions.find(request["function"].get<std::string>());
+            if (it == loaded->functions.end()) {
+                return errorReply("no function " + request["function"].get<std::string>() + " in " + path);
+            }
+            return {{"ok", true}, {"function", functionJson(it->second.report)}};
+        }
+        // "loop" or "branch"
+        if (!request.contains("line") || !request["line"].is_number_unsigned()) {
+            return errorReply("missing \"line\"");
+        }
+        unsigned line = request["line"].get<unsigned>();
+        std::string function = request.contains("function") && request["function"].is_string()
+                                   ? request["function"].get<std::string>() : std::string();
+        Json points = Json::array();
+        for (const std::string &name : loaded->order) {
+            if (!function.empty() && name != function) {
+                continue;
+            }
+            const SeminalFunctionReport &report = loaded->functions.find(name)->second.report;
+            for (const SeminalControlPointReport &point : op == "loop" ? report.loops : report.branches) {
+                if (point.line == line) {
+                    points.push_back(controlPointJson(point, report));
+                }
+            }
+        }
+        return {{"ok", true}, {op == "loop" ? "loops" : "branches", points}};
+    }
+
+private:
+    const FeatureSummaryIndex *index;
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const LoadedModule>> modules;
+
+    static std::string modulePath(const std::string &path) {
+        SmallString<256> absolute(path);
+        sys::fs::make_absolute(absolute);
+        return std::string(absolute);
+    }
+
+    std::shared_ptr<const LoadedModule> find(const std::string &path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = modules.find(path);
+        return it == modules.end() ? nullptr : it->second;
+    }
+
+    /**
+     * Function: load
+     *
+     * Description:
+     * Parses the module at 'path' into a fresh context and reports every function defined in it. On a reload, functions
+     * whose hashModuleFunctions hash matches the previously loaded version keep their report; only new and changed
+     * functions are analyzed, through visitModuleSeminalFeatures, so they share the module budgets and identical bodies
+     * are analyzed once. Parsing and analysis run without the lock, so queries on other modules (and on the
+     * previous version of this one) are answered meanwhile.
+     */
+
+    Json load(const std::string &path) {
+        auto start = std::chrono::steady_clock::now();
+        ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(path);
+        if (!buffer) {
+            return errorReply("cannot read " + path + ": " + buffer.getError().message());
+        }
+        auto loaded = std::make_shared<LoadedModule>(index);
+        SMDiagnostic err;
+        loaded->module = parseIR((*buffer)->getMemBufferRef(), err, loaded->context);
+        if (!loaded->module) {
+            std::string message;
+            raw_string_ostream OS(message);
+            err.print("seminal-daemon", OS);
+            return errorReply(OS.str());
+        }
+        loaded->analyses.prepare(*loaded->module);
+
+        std::shared_ptr<const LoadedModule> previous = find(path);
+        std::vector<std::pair<std::string, uint64_t>> hashes = hashModuleFunctions(
+            *loaded->module, &loaded->analyses.MAM.getResult<IndirectCallAnalysis>(*loaded->module));
+        size_t next = 0;
+        unsigned analyzed = 0, reused = 0;
+        StringSet<> kept;
+        for (Function &F : *loaded->module) {
+            if (F.isDeclaration()) {
+                continue;
+            }
+            FunctionEntry entry;
+            entry.hash = hashes[next++].second;
+            auto old = previous ? previous->functions.find(F.getName()) : StringMap<FunctionEntry>::const_iterator();
+            if (previous && old != previous->functions.end() && old->second.hash == entry.hash) {
+                entry.report = old->second.report;
+                kept.insert(F.getName());
+                ++reused;
+            }
+            loaded->order.push_back(F.getName().str());
+            loaded->functions[F.getName()] = std::move(entry);
+        }
+        visitModuleSeminalFeatures(*loaded->module, loaded->analyses.FAM,
+            [&](const Function &F, const SeminalFeatureInfo &info) {
+                loaded->functions[F.getName()].report = reportFunction(F, info);
+                ++analyzed;
+            },
+            [&](const Function &F) { return kept.count(F.getName()) != 0; });
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            modules[path] = loaded;
+        }
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return {{"ok", true}, {"module", path}, {"analyzed", analyzed}, {"reused", reused},
+                {"milliseconds", milliseconds}};
+    }
+};
+
+    bool writeAll(int fd, const std::string &data) {
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            written += n;
+        }
+        return true;
+    }
+
+    // Reads up to and including the next newline into 'line' (without it), keeping what follows in 'pending'.
+    bool readLine(int fd, std::string &pending, std::string &line) {
+        while (true) {
+            size_t newline = pending.find('\n');
+            if (newline != std::string::npos) {
+                line = pending.substr(0, newline);
+                pending.erase(0, newline + 1);
+                return true;
+            }
+            char chunk[4096];
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            pending.append(chunk, n);
+        }
+    }
+
+    int connectTo(const std::string &path, bool listen) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            errs() << "Socket path " << path << " is too long\n";
+            return -1;
+        }
+        std::strcpy(address.sun_path, path.c_str());
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            errs() << "Cannot create a socket: " << std::strerror(errno) << "\n";
+            return -1;
+        }
+        int result;
+        if (listen) {
+            // A socket file left by a daemon that did not shut down cleanly would make bind fail.
+            ::unlink(path.c_str());
+            result = ::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            if (result == 0) {
+                result = ::listen(fd, 16);
+            }
+        } else {
+            result = ::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        }
+        if (result != 0) {
+            errs() << "Cannot " << (listen ? "listen on " : "connect to ") << path << ": " << std::strerror(errno) << "\n";
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int sendRequest() {
+        int fd = connectTo(SocketPath, /*listen=*/false);
+        if (fd < 0) {
+            return 1;
+        }
+        std::string pending, reply;
+        bool ok = writeAll(fd, SendRequest + "\n") && readLine(fd, pending, reply);
+        ::close(fd);
+        if (!ok) {
+            errs() << "No reply from " << SocketPath << "\n";
+            return 1;
+        }
+        Json json = Json::parse(reply, nullptr, /*allow_exceptions=*/false);
+        outs() << (json.is_discarded() ? reply : json.dump(4)) << "\n";
+        return json.is_object() && json.value("ok", false) ? 0 : 1;
+    }
+
+}  // end of anonymous namespace
+
+int main(int argc, char **argv) {
+    InitLLVM X(argc, argv);
+    cl::ParseCommandLineOptions(argc, argv, "Seminal input feature query daemon\n");
+    // A client hanging up before its reply is written must not kill the daemon.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (!SendRequest.empty()) {
+        return sendRequest();
+    }
+
+    FeatureSummaryIndex index;
+    bool haveIndex = !SummaryIndexFile.empty();
+    if (haveIndex && !index.load(SummaryIndexFile)) {
+        return 1;
+    }
+
+    int listenFd = connectTo(SocketPath, /*listen=*/true);
+    if (listenFd < 0) {
+        return 1;
+    }
+    // RemoveFileOnSignal only removes regular files, so the socket is unlinked by an interrupt handler of our own.
+    static char socketToRemove[sizeof(sockaddr_un::sun_path)];
+    std::strcpy(socketToRemove, SocketPath.c_str());
+    sys::SetInterruptFunction([] { ::unlink(socketToRemove); });
+    errs() << "seminal-daemon listening on " << SocketPath << "\n";
+
+    Daemon daemon(haveIndex ? &index : nullptr);
+    std::mutex clientsMutex;
+    std::condition_variable clientsDone;
+    std::set<int> clients;
+    bool stopping = false;
+
+    while (true) {
+        int clientFd = ::accept(listenFd, nullptr, nullptr);
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (stopping) {
+            if (clientFd >= 0) {
+                ::close(clientFd);
+            }
+            break;
+        }
+        if (clientFd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            errs() << "accept failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+        clients.insert(clientFd);
+        std::thread([&, clientFd] {
+            std::string pending, line;
+            bool shutdown = false;
+            while (!shutdown && readLine(clientFd, pending, line)) {
+                if (StringRef(line).trim().empty()) {
+                    continue;
+                }
+                Json request = Json::parse(line, nullptr, /*allow_exceptions=*/false);
+                Json reply = request.is_discarded() ? errorReply("malformed JSON") : daemon.handle(request, shutdown);
+                if (!writeAll(clientFd, reply.dump() + "\n")) {
+                    break;
+                }
+            }
+            if (shutdown) {
+                {
+                    std::lock_guard<std::mutex> lock(clientsMutex);
+                    stopping = true;
+                    for (int other : clients) {
+                        if (other != clientFd) {
+                            ::shutdown(other, SHUT_RDWR);
+                        }
+                    }
+                }
+                // Wakes the accept loop with a connection of our own; it sees 'stopping' and exits.
+                int wakeFd = connectTo(SocketPath, /*listen=*/false);
+                if (wakeFd >= 0) {
+                    ::close(wakeFd);
+                }
+            }
+            // Closed only once it is out of 'clients', under the lock, so a shutdown of the other clients never hits a
+            // descriptor number that accept has already handed to a new connection.
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.erase(clientFd);
+            ::close(clientFd);
+            clientsDone.notify_all();
+        }).detach();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(clientsMutex);
+        for (int other : clients) {
+            ::shutdown(other, SHUT_RDWR);
+        }
+        clientsDone.wait(lock, [&] { return clients.empty(); });
+    }
+    ::close(listenFd);
+    ::unlink(SocketPath.c_str());
+    return 0;
+}